@@ -5,32 +5,38 @@
 #include <p2switches.h>
 #include <shape.h>
 #include <abCircle.h>
+#include <profile.h>
 
 #define GREEN_LED BIT6
 
-/** Moving Layer
- *  Linked list of layer references
- *  Velocity represents one iteration of change (direction & magnitude)
- */ 
-typedef struct MovLayer_s {
-  Layer *layer;
-  Vec2 velocity;
-  struct MovLayer_s *next;
-} MovLayer;
+// Frame Profiler Stages, Build With CFLAGS += -DPROFILE To Enable It
+#define PROF_STEP 0 // Moving The Bars And Ball
+#define PROF_COLLIDE 1 // Collision Checks
+#define PROF_DRAW 2 // Redrawing Movers And Sparks
+#define PROF_HUD 3 // Score Text
+#define PROF_IDLE 4 // CPU Off, Waiting For The Next Step
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, {10,10}}; // 10x10 rectangle 
-AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, 30}; // A Right Arrow 
-AbRect pongBar = {abRectGetBounds, abRectCheck, {14,3}}; // Bars for Pong
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectSpan, {10,10}}; // 10x10 rectangle 
+const AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, 0, 30}; // A Right Arrow 
+const AbRect pongBar = {abRectGetBounds, abRectCheck, abRectSpan, {14,3}}; // Bars for Pong
+
+// Pong Ball, Sized By Difficulty Using Chord Tables Computed At Runtime
+#define BALL_MAX_RADIUS 7
+#define BALL_CHORD_SLOTS 2
+AbDynCircle ballCircle = {abCircleGetBounds, abCircleCheck, abCircleSpan, 0, 0};
+ChordCache ballChords;
+ChordSlot ballChordSlots[BALL_CHORD_SLOTS];
+u_char ballChordStore[BALL_CHORD_SLOTS * (BALL_MAX_RADIUS + 1)];
 
 // Playing Field Frame
-AbRectOutline fieldOutline = {	
-  abRectOutlineGetBounds, abRectOutlineCheck,   
+const AbRectOutline fieldOutline = {	
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineSpan,  
   {screenWidth/2 - 3, screenHeight/2 - 1}
 };
 
 // Frame Around Difficulty Settings On Main Menu
-AbRectOutline selectorOutline = {
-  abRectOutlineGetBounds, abRectOutlineCheck,   
+const AbRectOutline selectorOutline = {
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineSpan,  
   {55, 8}
 };
 
@@ -49,109 +55,108 @@ static char playerTwoScore; // Controls Player Two's Score
 static char* winner; // To Print Out A Winner When Game Ends
 int switches; // To Read Input From Switches
 
+#define SPARK_BUDGET 24 // Maximum Number Of Live Sparks
+static u_char sparkStore[SPARK_BUDGET * PARTICLE_BYTES]; // Storage For Spark Particles
+static ParticleSys sparks; // Sparks Shown On Collisions And Scores
+static Vec2 burstPos; // Where The Next Burst Of Sparks Starts
+static char burstSize = 0; // Number Of Sparks The Next Burst Emits
+
+// Score Text, The Score Characters Are Updated As Players Score
+char playerOneString[] = "Player 1 - 0";
+char playerTwoString[] = "0 - Player 2";
+#define PLAYER_ONE_SCORE_INDEX 11 // Where The Score Is Within playerOneString
+#define PLAYER_TWO_SCORE_INDEX 0 // Where The Score Is Within playerTwoString
+const AbText playerOneText = {abTextGetBounds, abTextCheck, abTextSpan, playerOneString};
+const AbText playerTwoText = {abTextGetBounds, abTextCheck, abTextSpan, playerTwoString};
+
+// Layer Descriptors (Read-Only, Kept In Flash)
+const LayerDesc selectorDesc = {(const AbShape *) &selectorOutline, COLOR_WHITE, 0};
+const LayerDesc fieldDesc = {(const AbShape *) &fieldOutline, COLOR_BLACK, 3};
+const LayerDesc pongBarDesc = {(const AbShape *) &capsule14x3, COLOR_WHITE, 1}; // Rounded, pongBar Is Used For Collisions
+const LayerDesc pongBallDesc = {(const AbShape *) &ballCircle, COLOR_WHITE, 0};
+const LayerDesc playerOneDesc = {(const AbShape *) &playerOneText, COLOR_WHITE, 2};
+const LayerDesc playerTwoDesc = {(const AbShape *) &playerTwoText, COLOR_WHITE, 2};
+
 // Layer Around Difficulty Settings On Main Menu
 Layer selectorLayer = {
-  (AbShape *) &selectorOutline,
+  &selectorDesc,
   {65, 83},
   {0,0}, {0,0},				    
-  COLOR_WHITE,
   0
 };
 
 // Playing Field Layer
 Layer fieldLayer = {		
-  (AbShape *) &fieldOutline,
+  &fieldDesc,
   {screenWidth/2, screenHeight/2},
   {0,0}, {0,0},				    
-  COLOR_BLACK,
   0
 };
 
+// Player Two's Name And Score, Below Moving Objects
+Layer playerTwoLayer = {
+  &playerTwoDesc,
+  {screenWidth/2 - 14, screenHeight-10},
+  {0,0}, {0,0},
+  &fieldLayer
+};
+
+// Player One's Name And Score, Below Moving Objects
+Layer playerOneLayer = {
+  &playerOneDesc,
+  {7, 5},
+  {0,0}, {0,0},
+  &playerTwoLayer
+};
+
 // Top Pong Bar Layer
 Layer topPongBar = {
-  (AbShape *)&pongBar,
+  &pongBarDesc,
   {(screenWidth/2), 30},
   {0,0}, {0,0},
-  COLOR_WHITE,
-  &fieldLayer
+  &playerOneLayer
 };
 
 // Bottom Pong Bar Layer
 Layer bottomPongBar = {
-(AbShape *)&pongBar,
+  &pongBarDesc,
   {(screenWidth/2), screenHeight-30},
   {0,0}, {0,0},
-  COLOR_WHITE,
   &topPongBar
 };
 
 // Pong Ball Layer
 Layer pongBall = {		
-  (AbShape *)&circle7,
+  &pongBallDesc,
   {(screenWidth/2)+10, (screenHeight/2)-10}, 
   {0,0}, {0,0},				    
-  COLOR_WHITE,
   &bottomPongBar,
 };
 
-// Moving Layer For The Top Pong Bar
-MovLayer mtopPongBar = {&topPongBar, {1,1}, 0};
-// Moving Layer For The Bottom Pong Bar
-MovLayer mbottomPongBar = {&bottomPongBar, {1,1}, 0};
-// Moving Layer For The Pong Ball
-MovLayer mpongBall = {&pongBall, {2,1}, 0}; 
-
-// Draws A Moving Layer On The LCD Panel
-movLayerDraw(MovLayer *movLayers, Layer *layers)
-{
-  int row, col;
-  MovLayer *movLayer;
-  and_sr(~8);			/**< disable interrupts (GIE off) */
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
-    Layer *l = movLayer->layer;
-    l->posLast = l->pos;
-    l->pos = l->posNext;
-  }
-  or_sr(8);			/**< disable interrupts (GIE on) */
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
-    Region bounds;
-    layerGetBounds(movLayer->layer, &bounds);
-    lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], bounds.botRight.axes[0], bounds.botRight.axes[1]);
-    for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-      for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-	Vec2 pixelPos = {col, row};
-	u_int color = bgColor;
-	Layer *probeLayer;
-	for (probeLayer = layers; probeLayer; 
-	     probeLayer = probeLayer->next) { /* probe all layers, in order */
-	  if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	    color = probeLayer->color;
-	    break; 
-	  } /* if probe check */
-	} // for checking all layers at col, row
-	lcd_writeColor(color); 
-      } // for col
-    } // for row
-  } // for moving layer being updated
-}	  
+// Indices Of The Moving Layers Within movers
+#define BALL 0
+#define TOP_BAR 1
+#define BOTTOM_BAR 2
+MOTION_SET(movers, 3); // Next Positions And Velocities Of The Ball And Bars
+Region fieldFence; // Fence Around Playing Field, Shrunk For Each Mover By motionSetFence
 
 // Increments The Ball's Velocity
-void incrementBallVelocity(MovLayer *pongBall){
+void incrementBallVelocity(Vec2 *velocity){
   // Only Increment A Set Amount Of Times, Determined By The Difficulty Mode
   if (velocityLimit < (8 + difficultyMode)){
     // Only Increment The X-Axis Velocity Once The Y-Axis Velocity Has Been Incremented Twice
     if ( incrementX == 2) {
-      if (pongBall->velocity.axes[0] < 0){
-        pongBall->velocity.axes[0]--;
+      if (velocity->axes[0] < 0){
+        velocity->axes[0]--;
       } else {
-        pongBall->velocity.axes[0]++;
+        velocity->axes[0]++;
       }
       incrementX = 0;
     } else {
-      if (pongBall->velocity.axes[1] < 0){
-        pongBall->velocity.axes[1]--;
+      if (velocity->axes[1] < 0){
+        velocity->axes[1]--;
       } else {
-        pongBall->velocity.axes[1]++;
+        velocity->axes[1]++;
       }
       incrementX++;
     }
@@ -160,28 +165,27 @@ void incrementBallVelocity(MovLayer *pongBall){
 }
 
 // Resets The Ball's Velocity To It's Starting Values
-void resetBallVelocity(MovLayer *pongBall){
+void resetBallVelocity(Vec2 *velocity){
   velocityLimit = 0; // Restores The Velocity Limit, Allowing The Ball To Accelerate Again
-  pongBall->velocity.axes[0] = startingXSpeed;
-  pongBall->velocity.axes[1] = startingYSpeed;
+  velocity->axes[0] = startingXSpeed;
+  velocity->axes[1] = startingYSpeed;
 }
 
 // Returns The Pong Bars To It's Starting Positions
 void resetPongBars(){
-  mtopPongBar.layer->posNext.axes[0] = screenWidth/2;
-  mbottomPongBar.layer->posNext.axes[0] = screenWidth/2;
-  movLayerDraw(&mtopPongBar, &topPongBar);
-  movLayerDraw(&mbottomPongBar, &bottomPongBar);
+  movers.pos[TOP_BAR].axes[0] = screenWidth/2;
+  movers.pos[BOTTOM_BAR].axes[0] = screenWidth/2;
 }
 
 // Moves The Top Pong Bar
 void movtopPongBar(int switches){
   // Moves The Bar According To It's Current Position And How Much Its Set To Move
-  mtopPongBar.layer->posNext.axes[0] = mtopPongBar.layer->pos.axes[0] + topPongBarXPosition; 
+  Vec2 *barPos = &movers.pos[TOP_BAR];
+  barPos->axes[0] += topPongBarXPosition;
   // If The 1st Button Is Pressed Move Bar To The Left
   if (!(BIT0 & switches)){
     // Only Move Provided The Move Won't Send The Bar Past The Fence
-    if (mtopPongBar.layer->posNext.axes[0] >= 31){
+    if (barPos->axes[0] >= 31){
       topPongBarXPosition = -13;
     } else {
       topPongBarXPosition = 0;
@@ -190,7 +194,7 @@ void movtopPongBar(int switches){
   // If The 2nd Button Is Pressed Move Bar To The Right
   else if (!(BIT1 & switches)){
     // Only Move Provided The Move Won't Send The Bar Past The Fence
-    if (mtopPongBar.layer->posNext.axes[0] <= screenWidth - 31){
+    if (barPos->axes[0] <= screenWidth - 31){
       topPongBarXPosition = 13;
     } else {
       topPongBarXPosition = 0;
@@ -200,18 +204,17 @@ void movtopPongBar(int switches){
   else {
     topPongBarXPosition = 0;
   }
-  // Redraw The Bar To Reflect Change
-  movLayerDraw(&mtopPongBar, &topPongBar);
 }
 
 // Moves The Bottom Pong Bar
 void movbottomPongBar(int switches){
   // Moves The Bar According To It's Current Position And How Much Its Set To Move
-  mbottomPongBar.layer->posNext.axes[0] = mbottomPongBar.layer->pos.axes[0] + bottomPongBarXPosition;
+  Vec2 *barPos = &movers.pos[BOTTOM_BAR];
+  barPos->axes[0] += bottomPongBarXPosition;
   // If The 3rd Button Is Pressed Move Bar To The Left
   if (!(BIT2 &switches)){
     // Only Move Provided The Move Won't Send The Bar Past The Fence
-    if (mbottomPongBar.layer->posNext.axes[0] >= 31){
+    if (barPos->axes[0] >= 31){
       bottomPongBarXPosition = -13;
     } else {
       bottomPongBarXPosition = 0;
@@ -220,7 +223,7 @@ void movbottomPongBar(int switches){
   // If The 4th Button Is Pressed Move Bar To The Right
   else if (!(BIT3 & switches)){
     // Only Move Provided The Move Won't Send The Bar Past The Fence
-    if (mbottomPongBar.layer->posNext.axes[0] <= screenWidth - 31){
+    if (barPos->axes[0] <= screenWidth - 31){
       bottomPongBarXPosition = 13;
     }  else {
       bottomPongBarXPosition = 0;
@@ -230,57 +233,26 @@ void movbottomPongBar(int switches){
   else {
     bottomPongBarXPosition = 0;
   }
-  // Redraw The Bar To Reflect Change
-  movLayerDraw(&mbottomPongBar, &bottomPongBar);
+}
+
+// Requests A Burst Of Sparks, Emitted And Drawn By The Main Loop
+void requestBurst(const Vec2 *pos, char size){
+  burstPos = *pos;
+  burstSize = size;
 }
 
 // Handles Fence Collisions, Resets The Pong Ball and Bars
-void handleCollisionOnFence(Vec2* newPos, MovLayer* ml){
+void handleCollisionOnFence(Vec2* newPos, Vec2* velocity){
+  requestBurst(newPos, 16); // Score Burst Where The Ball Left
   newPos->axes[0] = (screenWidth/2)+10; // Reset The Pong Ball's X-Position
   newPos->axes[1] = (screenHeight/2)-10; // Reset The Pong Ball's Y-Position
-  resetBallVelocity(ml);
+  resetBallVelocity(velocity);
   resetPongBars();
   collisionBottomOccurred = 0;
   collisionTopOccured = 0;
   playCollisionSoundOnFence(); // In buzzerFunctions Assembly File
 }
 
-// Detects If A Collision Ocurred On The Bottom Section Of The Fence
-int detectCollisionBottomFence(const AbRect* rect, const Vec2* centerPos, const Vec2 *pixel){
-  int i = 0;
-  Vec2 centerPos1 = *centerPos; // Retrieves The Fence's Center Position
-  // Traverses All The Pixels On The Bottom Section Of The Fence 
-  for (i = -100; i < 100; i++){
-    centerPos1.axes[0] += i;
-    centerPos1.axes[1] += 50;
-    int collision = abRectCheck(rect, &centerPos1, pixel); // Checks If The Ball Center Position And Fence Collided
-    if (collision){
-      return 1;
-    }
-    centerPos1.axes[0] -= i;
-    centerPos1.axes[1] -= 50;
-  }
-  return 0;
-}
-
-// Detects If A Collision Ocurred On The Top Section Of The Fence
-int detectCollisionTopFence(const AbRect* rect, const Vec2* centerPos, const Vec2 *pixel){
-  int i = 0;
-  Vec2 centerPos1 = *centerPos; // Retrieves The Fence's Center Position
-  // Traverses All The Pixels On The Top Section Of The Fence 
-  for (i = -100; i < 100; i++){
-    centerPos1.axes[0] += i;
-    centerPos1.axes[1] -= 50;
-    int collision = abRectCheck(rect, &centerPos1, pixel); // Checks If The Ball Center Position And Fence Collided
-    if (collision){
-      return 1;
-    }
-    centerPos1.axes[0] -= i;
-    centerPos1.axes[1] += 50;
-  }
-  return 0;
-}
-
 // Detects If A Collision Ocurred On The Top Pong Bar
 int detectCollisionTopPongBar(const AbRect* rect, const Vec2* centerPos, const Vec2 *pixel){
   int i;
@@ -328,59 +300,124 @@ int detectCollisionBottomPongBar(const AbRect* rect, const Vec2* centerPos, cons
 }
 
 /** Advances The Ball Within The Fence, Probing For Collision With The Fence Or Pong Bars.
- *  \param ml The moving shape to be advanced
- *  \param fence The region which will serve as a boundary for ml
+ *  \param m The motion set holding the ball and bars
  */
-void mlAdvance(MovLayer *ml, Region *fence){
-  Vec2 newPos;
-  u_char axis;
-  Region shapeBoundary;
+void advanceBall(MotionSet *m){
+  Vec2 *newPos = &m->pos[BALL];
+  Vec2 *velocity = &m->vel[BALL];
+  Vec2 ballPos = *newPos; // Where The Ball Was Before This Step
   resetSound();
-  for (; ml; ml = ml->next) {
-    vec2Add(&newPos, &ml->layer->posNext, &ml->velocity);
-    abShapeGetBounds(ml->layer->abShape, &newPos, &shapeBoundary);
-    for (axis = 0; axis < 2; axis++) {
-      // If the ball hits the fence
-      if ((shapeBoundary.topLeft.axes[axis] < fence->topLeft.axes[axis]) || (shapeBoundary.botRight.axes[axis] > fence->botRight.axes[axis])){
-        // If The Ball Hits The Top Part Of The Fence
-        if (detectCollisionTopFence(&fieldOutline, &(fieldLayer.pos), &(ml->layer->pos)) && axis == 1){
-          handleCollisionOnFence(&newPos, ml);
-          playerTwoScore++;
-        } 
-        // If The Ball Hits The Bottom Part Of The Fence
-        else if (detectCollisionBottomFence(&fieldOutline, &(fieldLayer.pos), &(ml->layer->pos)) && axis == 1){
-          handleCollisionOnFence(&newPos, ml);
-          playerOneScore++;
-        } 
-        else { 
-          int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-          newPos.axes[axis] += (2*velocity); // Inverts Ball Direction
-        }
-      }
-      // If the ball hits the top pong bar, only checking on the Y-Axis 
-      if (detectCollisionTopPongBar(&pongBar, &(topPongBar.pos), &(ml->layer->pos)) && axis == 1){
-        int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-        newPos.axes[axis] += (2*velocity); // Inverts Ball Direction
-        incrementBallVelocity(ml);
-        collisionBottomOccurred = 0;
-        collisionTopOccured = 1;
-        playCollisionSoundOnBar(); // In buzzerFunctions Assembly File
-      }
-      // If the ball hits the bottom pong bar, only checking on the Y-Axis
-      if (detectCollisionBottomPongBar(&pongBar, &(bottomPongBar.pos), &(ml->layer->pos)) && axis == 1){
-        int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-        newPos.axes[axis] += (2*velocity); // Inverts Ball Direction
-        incrementBallVelocity(ml); 
-        collisionBottomOccurred = 1;
-        collisionTopOccured = 0;
-        playCollisionSoundOnBar(); // In buzzerFunctions Assembly File
-      }
-    }
-    // Sets The Ball's Next Position
-    ml->layer->posNext = newPos;
+  // Moves Everything, Reflecting The Ball Off The Fence
+  motionAdvance(m);
+  PROFILE_MARK(PROF_COLLIDE);
+  // If The Ball Hits The Top Part Of The Fence
+  if (m->hit[BALL] & MOTION_HIT_TOP){
+    handleCollisionOnFence(newPos, velocity);
+    playerTwoScore++;
+  } 
+  // If The Ball Hits The Bottom Part Of The Fence
+  else if (m->hit[BALL] & MOTION_HIT_BOTTOM){
+    handleCollisionOnFence(newPos, velocity);
+    playerOneScore++;
+  } 
+  // If the ball hits the top pong bar, only checking on the Y-Axis 
+  if (detectCollisionTopPongBar(&pongBar, &m->pos[TOP_BAR], &ballPos)){
+    int v = velocity->axes[1] = -velocity->axes[1];
+    newPos->axes[1] += (2*v); // Inverts Ball Direction
+    incrementBallVelocity(velocity);
+    collisionBottomOccurred = 0;
+    collisionTopOccured = 1;
+    requestBurst(&ballPos, 6);
+    playCollisionSoundOnBar(); // In buzzerFunctions Assembly File
+  }
+  // If the ball hits the bottom pong bar, only checking on the Y-Axis
+  if (detectCollisionBottomPongBar(&pongBar, &m->pos[BOTTOM_BAR], &ballPos)){
+    int v = velocity->axes[1] = -velocity->axes[1];
+    newPos->axes[1] += (2*v); // Inverts Ball Direction
+    incrementBallVelocity(velocity); 
+    collisionBottomOccurred = 1;
+    collisionTopOccured = 0;
+    requestBurst(&ballPos, 6);
+    playCollisionSoundOnBar(); // In buzzerFunctions Assembly File
+  }
+}
+
+// Redraws A Player's Score Text, Only When The Score Has Changed
+void updateScoreText(Layer *textLayer, char *scoreChar, char score){
+  if (*scoreChar != score){
+    Region bounds;
+    *scoreChar = score;
+    layerGetBounds(textLayer, &bounds);
+    layerDrawRegion(&pongBall, &bounds);
   }
 }
  
+// Draws A Label Followed By A Decimal Rate, For The Clock And CPU Load Reports
+void drawRate(u_char row, char *label, unsigned long rate, char *units){
+  char digits[11];
+  char *p = &digits[10];
+  *p = 0;
+  do {
+    *--p = '0' + rate % 10;
+    rate /= 10;
+  } while (rate);
+  drawString5x7(5, row, label, COLOR_GREEN, COLOR_BLACK);
+  drawString5x7(35, row, p, COLOR_GREEN, COLOR_BLACK);
+  drawString5x7(95, row, units, COLOR_GREEN, COLOR_BLACK);
+}
+
+#define PHYSICS_HZ 17 // Rate The Game Is Simulated At
+u_char wdtTicksPerCall = 14; // WDT Ticks Per wdt_c_handler Call (One Simulation Step), Set From The Clock Plan
+Scheduler pongSched; // Runs pongStep At PHYSICS_HZ And pongRender When The CPU Keeps Up
+#define WORK_SLOTS 4
+static WorkItem workSlots[WORK_SLOTS];
+WorkQueue work; // Soft Timer Callbacks, Posted By wdt_c_handler And Run By main
+
+// One Fixed Timestep Of The Game: Moves The Bars And Ball
+void pongStep(){
+  PROFILE_MARK(PROF_STEP);
+  movtopPongBar(switches);
+  movbottomPongBar(switches);
+  advanceBall(&movers);
+}
+
+// Draws The Game After Any Steps Since The Last Render
+void pongRender(){
+  PROFILE_MARK(PROF_DRAW);
+  // Moves The Ball And Bars On Screen
+  motionCommit(&movers);
+  motionDraw(&movers, &pongBall);
+  // Emits Any Requested Sparks And Animates Them
+  if (burstSize){
+    particleBurst(&sparks, burstPos.axes[0], burstPos.axes[1], burstSize, 2, 12);
+    burstSize = 0;
+  }
+  particleAdvance(&sparks);
+  particleDraw(&sparks, &pongBall);
+  // Checks If Either Player Has Scored 10 Times And Terminates The Game
+  if (playerOneScore == '5' || playerTwoScore == '5'){
+    if (playerOneScore == '5'){
+      winner = "Player 1 Won!";
+      playerOneScore = 'W';
+    } else {
+      winner = "Player 2 Won!";
+      playerTwoScore = 'W';
+    }
+    modeSelector = 2;
+    sparks.count = 0; // Discards Any Live Sparks
+    clearScreen(0);
+  } else {
+    // Redraws The Player's Scores If They Changed, Names And Scores Are Layers
+    // So Moving Objects Pass Over Them Without Erasing Them
+    PROFILE_MARK(PROF_HUD);
+    updateScoreText(&playerOneLayer, &playerOneString[PLAYER_ONE_SCORE_INDEX], playerOneScore);
+    updateScoreText(&playerTwoLayer, &playerTwoString[PLAYER_TWO_SCORE_INDEX], playerTwoScore);
+    // Frame ms And Stage Percentages (Step, Collide, Draw, HUD, Idle)
+    PROFILE_DRAW(2, 15);
+  }
+  PROFILE_FRAME();
+}
+
 void selectMode(){
   // Menu Screen, Lets User Set Difficulty Mode And Start Game 
   if (modeSelector == 0){
@@ -392,18 +429,26 @@ void selectMode(){
     // Starts The Game
     if (!(BIT0 & switches)) { 
       clearScreen(0);
-      _delay(50);
+      sleepMs(500); // Lets Go Of BTN1 Before It's Read Again
       playerTwoScore = '0';
       playerOneScore = '0';
+      schedInit(&pongSched, pongStep, pongRender, 1); // Steps Start Once modeSelector Is 1
+      idleInit(); // CPU Load Covers The Game, Not The Menu
       modeSelector = 1;
-      mpongBall.velocity.axes[0] = startingXSpeed;
-      mpongBall.velocity.axes[1] = startingYSpeed;
+      movers.vel[BALL].axes[0] = startingXSpeed;
+      movers.vel[BALL].axes[1] = startingYSpeed;
+      // Draws The Playing Field, Bars, Ball, And Scores
+      playerOneString[PLAYER_ONE_SCORE_INDEX] = playerOneScore;
+      playerTwoString[PLAYER_TWO_SCORE_INDEX] = playerTwoScore;
+      layerDraw(&pongBall);
     }
     // Sets Easy Difficulty Mode
     else if (!(BIT1 & switches)){
       selectorLayer.pos.axes[1] = 83;
       layerDraw(&selectorLayer);
       startingXSpeed = 2;
+      abDynCircleSetRadius(&ballCircle, &ballChords, 7);
+      motionSetFence(&movers, BALL, &fieldFence); // Bounce Where This Radius Meets The Walls
       startingYSpeed = 1;
       difficultyMode = -2;
     }
@@ -412,6 +457,8 @@ void selectMode(){
       selectorLayer.pos.axes[1] = 103;
       layerDraw(&selectorLayer);
       startingXSpeed = 3;
+      abDynCircleSetRadius(&ballCircle, &ballChords, 5);
+      motionSetFence(&movers, BALL, &fieldFence); // Bounce Where This Radius Meets The Walls
       startingYSpeed = 2;
       difficultyMode = 2;
     }
@@ -420,6 +467,8 @@ void selectMode(){
       selectorLayer.pos.axes[1] = 123;
       layerDraw(&selectorLayer);
       startingXSpeed = 4;
+      abDynCircleSetRadius(&ballCircle, &ballChords, 4);
+      motionSetFence(&movers, BALL, &fieldFence); // Bounce Where This Radius Meets The Walls
       startingYSpeed = 3;
       difficultyMode = 6;
     }
@@ -433,10 +482,13 @@ void selectMode(){
     drawString5x7(10, 60, "  Game Over", COLOR_WHITE, COLOR_BLACK);
     drawString5x7(15, 80, winner, COLOR_WHITE, COLOR_BLACK);
     drawString5x7(15, 100, " BTN1 - Menu", COLOR_WHITE, COLOR_BLACK);
+    // CPU Load During The Game's Last Second
+    drawRate(115, "CPU", cpuLoad.percent, "%");
+    drawRate(125, "Busy", cpuLoad.worstBusy / (clockPlan.smclkHz / 1000000), "us");
     // Restart Game, Going Back To Menu 
     if (!(BIT0 & switches)) {
       clearScreen(0);
-      _delay(50);
+      sleepMs(500); // Lets Go Of BTN1 Before It's Read Again
       selectorLayer.pos.axes[1] = 83;
       startingXSpeed = 2;
       startingYSpeed = 1;
@@ -458,7 +510,6 @@ void initializeBuzzer(){
 
 u_int bgColor = COLOR_BLACK; // The background color 
 int redrawScreen = 1; // Boolean for whether screen needs to be redrawn 
-Region fieldFence; // Fence Around Playing Field 
 
 /** Initializes everything, enables interrupts and green LED, 
  *  and handles the rendering for the screen
@@ -469,18 +520,33 @@ void main()
   P1OUT |= GREEN_LED;
   
   // Initializes Everything
-  configureClocks();
+  configureClockPlan(TICK_WDT_VLO); // SPI At Full SMCLK, Game Tick From The VLO
+  timeInit(); // Time Base For CPU Load Accounting
+  PROFILE_INIT();
+  // Soft Timers Tick With Each wdt_c_handler Call, So Delays Sleep
+  wdtTicksPerCall = (clockPlan.tickHz + PHYSICS_HZ / 2) / PHYSICS_HZ;
+  workInit(&work, workSlots, WORK_SLOTS);
+  softTimerInit(&work, clockPlan.tickHz / wdtTicksPerCall);
+  enableWDTInterrupts();      /**< enable periodic interrupt */
+  or_sr(0x8);	              /**< GIE (enable interrupts) */
+  lcd_sleepMs = sleepMs;
   lcd_init();
   p2sw_init(BIT0 + BIT1 + BIT2 + BIT3);
   initializeBuzzer();
   clearScreen(0);
+  // Reports The Effective Clock Rates Below The Menu
+  drawRate(140, "SPI", lcd_spiHz(clockPlan.smclkHz) / 1000, "kHz");
+  drawRate(150, "Tick", clockPlan.tickHz, "Hz");
   shapeInit();
+  chordCacheInit(&ballChords, ballChordSlots, BALL_CHORD_SLOTS, ballChordStore, BALL_MAX_RADIUS);
+  abDynCircleSetRadius(&ballCircle, &ballChords, BALL_MAX_RADIUS); // Easy
   layerInit(&pongBall);
   layerDraw(&selectorLayer);
   layerGetBounds(&fieldLayer, &fieldFence); 
-   
-  enableWDTInterrupts();      /**< enable periodic interrupt */
-  or_sr(0x8);	              /**< GIE (enable interrupts) */
+  motionAdd(&movers, &pongBall, &vec2Zero, &fieldFence); // BALL
+  motionAdd(&movers, &topPongBar, &vec2Zero, 0); // TOP_BAR
+  motionAdd(&movers, &bottomPongBar, &vec2Zero, 0); // BOTTOM_BAR
+  particleInit(&sparks, sparkStore, SPARK_BUDGET, COLOR_YELLOW, 2, &fieldFence);
 
   for(;;) {
     // To Read Input From Switches
@@ -490,54 +556,38 @@ void main()
       selectMode();
     } 
     else {
-      while (!redrawScreen) { /**< Pause CPU if screen doesn't need updating */
+      workDrain(&work); // Runs Expired Soft Timers' Callbacks
+      PROFILE_MARK(PROF_IDLE);
+      for (;;) { /**< Pause CPU if screen doesn't need updating */
+        // Tests With Interrupts Off, So A Wakeup Can't Slip In Before The CPU Sleeps
+        unsigned int sr = critical_enter();
+        if (redrawScreen || workPending(&work)) {
+          critical_exit(sr);
+          break;
+        }
         P1OUT &= ~GREEN_LED;    /**< Green led off witHo CPU */
-        or_sr(0x10);	      /**< CPU OFF */
+        idleSleep();	      /**< CPU OFF (interrupts on), time counted in cpuLoad */
+        critical_exit(sr);
       }
       // Turns On The Green LED When CPU Is On
       P1OUT |= GREEN_LED;      
       redrawScreen = 0;
-      // Draws The Player's Name In A Corresponding Corner
-      drawString5x7(7, 5, "Player 1 - ", COLOR_WHITE, COLOR_BLACK);
-      drawString5x7(screenWidth/2 -2, screenHeight-10, "- Player 2", COLOR_WHITE, COLOR_BLACK);
-      // Checks Wether The Pong Bars Should Be Moved
-      movtopPongBar(switches);
-      movbottomPongBar(switches);
-      // Moves The Ball
-      movLayerDraw(&mpongBall, &pongBall);
-      // Checks If Either Player Has Scored 10 Times And Terminates The Game
-      if (playerOneScore == '5' || playerTwoScore == '5'){
-        if (playerOneScore == '5'){
-          winner = "Player 1 Won!";
-          playerOneScore = 'W';
-        } else {
-          winner = "Player 2 Won!";
-          playerTwoScore = 'W';
-        }
-        modeSelector = 2;
-        clearScreen(0);
-      }
-      // Draws The Player's Current Score
-      drawChar5x7(75, 5, playerOneScore, COLOR_WHITE, COLOR_BLACK);
-      drawChar5x7(screenWidth/2 - 15, screenHeight-10, playerTwoScore, COLOR_WHITE, COLOR_BLACK);
+      // Runs Every Simulation Step That's Due, Then Renders Once
+      schedRun(&pongSched);
     }
   }
 }
 
-/** Watchdog timer interrupt handler. 15 interrupts/sec */
+/** Watchdog timer interrupt handler, called by wdt_handler.s every
+ *  wdtTicksPerCall ticks (PHYSICS_HZ times/sec)
+ */
 void wdt_c_handler()
 {
-  static short count = 0;
   P1OUT |= GREEN_LED;		      /**< Green LED on when cpu on */
-  count ++;
-  if (count == 14) {
-    // To Keep Game From Starting During Menus
-    if (modeSelector == 1){
-      mlAdvance(&mpongBall, &fieldFence);
-    }
-    if (p2sw_read())
-      redrawScreen = 1;
-    count = 0;
-  }
+  // To Keep Game From Starting During Menus
+  if (modeSelector == 1 && schedTick(&pongSched))
+    redrawScreen = 1;		      /**< Wake main to run the step */
+  if (softTimerTick())
+    redrawScreen = 1;		      /**< Wake main to run timer callbacks */
   P1OUT &= ~GREEN_LED;		    /**< Green LED off when cpu off */
 }
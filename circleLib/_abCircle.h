@@ -7,11 +7,13 @@
  *  
  *  chords should be a vector of length radius + 1.  
  *  Entry at index i is 1/2 chord length at distance i from the circle's center.  
- *  This vector can be generated using lcdLib's computeChordVec() (lcddraw.h).
+ *  This vector can be generated using computeChordVec().
  */ 
 typedef struct AbCircle_s {
   void (*getBounds)(const struct AbCircle_s *circle, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
   const u_char *chords;
   const u_char radius;
 } AbCircle;
@@ -24,6 +26,156 @@ void abCircleGetBounds(const AbCircle *circle, const Vec2 *circlePos, Region *bo
  */
 int abCircleCheck(const AbCircle *circle, const Vec2 *circlePos, const Vec2 *pixel);
 
+/** Required by AbShape
+ */
+int abCircleSpan(const AbCircle *circle, const Vec2 *circlePos, const Vec2 *pixel,
+		 int *runEnd, u_int *color);
+
+/** Build chordVec (of length radius + 1) for a circle of radius radius,
+ *  using Bresenham's circle algorithm.
+ */
+void computeChordVec(u_char chordVec[], u_char radius);
+
+/** AbCircle whose radius can change at runtime (see abDynCircleSetRadius).
+ *  Laid out like AbCircle, so it uses the abCircle functions, 
+ *  but kept in RAM: {abCircleGetBounds, abCircleCheck, abCircleSpan, 0, 0}.
+ */
+typedef struct AbDynCircle_s {
+  void (*getBounds)(const struct AbCircle_s *circle, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  const u_char *chords;
+  u_char radius;
+} AbDynCircle;
+
+/** One chord table of a ChordCache.
+ *
+ *   - radius: radius of the table's circle, 0 if empty
+ *   - pins: number of circles using the table (it is not evicted while pinned)
+ *   - used: when the table was last requested, for LRU eviction
+ */
+typedef struct ChordSlot_s {
+  u_char radius, pins;
+  u_int used;
+  u_char *chords;
+} ChordSlot;
+
+/** A small RAM cache of chord tables, computed on demand.
+ *  Chord tables for circles of radius 1 to maxRadius are kept in slots, 
+ *  each with maxRadius + 1 bytes of store.
+ */
+typedef struct ChordCache_s {
+  ChordSlot *slots;
+  u_char numSlots, maxRadius;
+  u_int clock;			/**< incremented by each request */
+} ChordCache;
+
+/** Initialize cache.
+ *
+ *  \param slots (in) numSlots slots 
+ *  \param store (in) numSlots * (maxRadius + 1) bytes for the tables
+ */
+void chordCacheInit(ChordCache *cache, ChordSlot *slots, u_char numSlots, 
+		    u_char *store, u_char maxRadius);
+
+/** Find (or compute, evicting the least recently used unpinned table) the
+ *  chord table for radius, and pin it.
+ *
+ *  \return The table, or 0 if radius is out of range or every slot is pinned
+ */
+const u_char *chordCacheGet(ChordCache *cache, u_char radius);
+
+/** Unpin a table returned by chordCacheGet.
+ */
+void chordCacheRelease(ChordCache *cache, const u_char *chords);
+
+/** Resize circle, pinning its new chord table and releasing its old one.
+ *  Redraw the circle's old bounds as well as its new ones afterwards.
+ *
+ *  \return True (1) if resized, 0 (circle unchanged) if no table was available
+ */
+int abDynCircleSetRadius(AbDynCircle *circle, ChordCache *cache, u_char radius);
+
+#define PACKED_ROWS 16		/**< rows between AbPackedCircle checkpoints */
+#define PACKED_ESCAPE 3		/**< AbPackedCircle code: delta is the next escape */
+
+/** Where an AbPackedCircle was last decoded: the 1/2 width of row 
+ *  (distance from center) row, and the number of escapes used through it.
+ */
+typedef struct PackedCursor_s {
+  u_char row, halfWidth, escape;
+} PackedCursor;
+
+/** AbShape circle with a compressed chord vector, generated by makeCircles
+ *  as packedCircleN.  It covers the same pixels as circleN.
+ *
+ *  Row i's 1/2 width is the width of row i-1 less a 2 bit code (4 per byte,
+ *  low bits first) of codes; code PACKED_ESCAPE means the difference is 
+ *  instead the next byte of escapes.  checkpoints[k] holds the 1/2 width of
+ *  row k * PACKED_ROWS and the number of escapes used through that row.
+ *  Rows are decoded by stepping cursor (in RAM) from the previous row 
+ *  decoded, so drawing top to bottom decodes one code per row.
+ */
+typedef struct AbPackedCircle_s {
+  void (*getBounds)(const struct AbPackedCircle_s *circle, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbPackedCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbPackedCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  const u_char *codes;
+  const u_char *escapes;
+  const u_char (*checkpoints)[2];
+  PackedCursor *cursor;
+  const u_char radius;
+} AbPackedCircle;
+
+/** Required by AbShape
+ */
+void abPackedCircleGetBounds(const AbPackedCircle *circle, const Vec2 *circlePos, Region *bounds);
+
+/** Required by AbShape
+ */
+int abPackedCircleCheck(const AbPackedCircle *circle, const Vec2 *circlePos, const Vec2 *pixel);
+
+/** Required by AbShape
+ */
+int abPackedCircleSpan(const AbPackedCircle *circle, const Vec2 *circlePos, const Vec2 *pixel,
+		       int *runEnd, u_int *color);
+
+#define CHORD_NONE 0xff		/**< AbChords inner entry for a row with no hole */
+
+/** AbShape symmetric about its center both horizontally and vertically
+ *  (ellipses, capsules, rounded rectangles and rings).
+ *
+ *  outer should be a vector of length halfHeight + 1.  Entry at index i is
+ *  the shape's 1/2 width at vertical distance i from its center.  inner is 
+ *  0 for shapes without a hole, otherwise it has the same length and entry
+ *  i is the 1/2 width of the hole (CHORD_NONE if the row has no hole).
+ *  makeCircles generates these for the shapes listed in SHAPES (see Makefile).
+ */
+typedef struct AbChords_s {
+  void (*getBounds)(const struct AbChords_s *shape, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbChords_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbChords_s *shape, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  const u_char *outer;
+  const u_char *inner;
+  const u_char halfWidth, halfHeight;
+} AbChords;
+
+/** Required by AbShape
+ */
+void abChordsGetBounds(const AbChords *shape, const Vec2 *centerPos, Region *bounds);
+
+/** Required by AbShape
+ */
+int abChordsCheck(const AbChords *shape, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** Required by AbShape
+ */
+int abChordsSpan(const AbChords *shape, const Vec2 *centerPos, const Vec2 *pixel,
+		 int *runEnd, u_int *color);
+
 #endif
 
 
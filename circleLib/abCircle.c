@@ -11,6 +11,42 @@ int abCircleCheck(const AbCircle *circle, const Vec2 *centerPos, const Vec2 *pix
   vec2Abs(&relPos);		      /* project to first quadrant */
   return (relPos.axes[0] <= radius && circle->chords[relPos.axes[0]] >= relPos.axes[1]);
 }
+
+// half width of circle's chord at vertical distance dRow from its center (-1 if none)
+static int
+chordHalfWidth(const AbCircle *circle, int dRow)
+{
+  u_char radius = circle->radius;
+  int halfWidth;
+  if (dRow > radius)
+    return -1;
+  /* same membership rule as abCircleCheck: widest col with chords[col] >= dRow */
+  halfWidth = circle->chords[dRow];
+  while (halfWidth < radius && circle->chords[halfWidth+1] >= dRow)
+    halfWidth++;
+  while (halfWidth >= 0 && circle->chords[halfWidth] < dRow)
+    halfWidth--;
+  return halfWidth;
+}
+
+// like abCircleCheck, also finding the end of the run containing pixel
+int
+abCircleSpan(const AbCircle *circle, const Vec2 *centerPos, const Vec2 *pixel,
+	     int *runEnd, u_int *color)
+{
+  int dRow = pixel->axes[1] - centerPos->axes[1];
+  int col = pixel->axes[0], center = centerPos->axes[0];
+  int halfWidth = chordHalfWidth(circle, dRow < 0 ? -dRow : dRow);
+  if (halfWidth < 0 || col > center + halfWidth) {
+    *runEnd = SPAN_END;		/* never within on this row */
+    return 0;
+  } else if (col < center - halfWidth) {
+    *runEnd = center - halfWidth - 1;
+    return 0;
+  }
+  *runEnd = center + halfWidth;
+  return 1;
+}
   
 void
 abCircleGetBounds(const AbCircle *circle, const Vec2 *centerPos, Region *bounds)
@@ -20,6 +56,5 @@ abCircleGetBounds(const AbCircle *circle, const Vec2 *centerPos, Region *bounds)
     bounds->topLeft.axes[axis] = centerPos->axes[axis] - radius;
     bounds->botRight.axes[axis] = centerPos->axes[axis] + radius;
   }
-  regionClipScreen(bounds);
 }
 
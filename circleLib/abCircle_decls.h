@@ -3,153 +3,307 @@
 #define abCircle_decls_included
 
 extern const AbCircle circle2;
+extern const AbPackedCircle packedCircle2;
 extern const AbCircle circle3;
+extern const AbPackedCircle packedCircle3;
 extern const AbCircle circle4;
+extern const AbPackedCircle packedCircle4;
 extern const AbCircle circle5;
+extern const AbPackedCircle packedCircle5;
 extern const AbCircle circle6;
+extern const AbPackedCircle packedCircle6;
 extern const AbCircle circle7;
+extern const AbPackedCircle packedCircle7;
 extern const AbCircle circle8;
+extern const AbPackedCircle packedCircle8;
 extern const AbCircle circle9;
+extern const AbPackedCircle packedCircle9;
 extern const AbCircle circle10;
+extern const AbPackedCircle packedCircle10;
 extern const AbCircle circle11;
+extern const AbPackedCircle packedCircle11;
 extern const AbCircle circle12;
+extern const AbPackedCircle packedCircle12;
 extern const AbCircle circle13;
+extern const AbPackedCircle packedCircle13;
 extern const AbCircle circle14;
+extern const AbPackedCircle packedCircle14;
 extern const AbCircle circle15;
+extern const AbPackedCircle packedCircle15;
 extern const AbCircle circle16;
+extern const AbPackedCircle packedCircle16;
 extern const AbCircle circle17;
+extern const AbPackedCircle packedCircle17;
 extern const AbCircle circle18;
+extern const AbPackedCircle packedCircle18;
 extern const AbCircle circle19;
+extern const AbPackedCircle packedCircle19;
 extern const AbCircle circle20;
+extern const AbPackedCircle packedCircle20;
 extern const AbCircle circle21;
+extern const AbPackedCircle packedCircle21;
 extern const AbCircle circle22;
+extern const AbPackedCircle packedCircle22;
 extern const AbCircle circle23;
+extern const AbPackedCircle packedCircle23;
 extern const AbCircle circle24;
+extern const AbPackedCircle packedCircle24;
 extern const AbCircle circle25;
+extern const AbPackedCircle packedCircle25;
 extern const AbCircle circle26;
+extern const AbPackedCircle packedCircle26;
 extern const AbCircle circle27;
+extern const AbPackedCircle packedCircle27;
 extern const AbCircle circle28;
+extern const AbPackedCircle packedCircle28;
 extern const AbCircle circle29;
+extern const AbPackedCircle packedCircle29;
 extern const AbCircle circle30;
+extern const AbPackedCircle packedCircle30;
 extern const AbCircle circle31;
+extern const AbPackedCircle packedCircle31;
 extern const AbCircle circle32;
+extern const AbPackedCircle packedCircle32;
 extern const AbCircle circle33;
+extern const AbPackedCircle packedCircle33;
 extern const AbCircle circle34;
+extern const AbPackedCircle packedCircle34;
 extern const AbCircle circle35;
+extern const AbPackedCircle packedCircle35;
 extern const AbCircle circle36;
+extern const AbPackedCircle packedCircle36;
 extern const AbCircle circle37;
+extern const AbPackedCircle packedCircle37;
 extern const AbCircle circle38;
+extern const AbPackedCircle packedCircle38;
 extern const AbCircle circle39;
+extern const AbPackedCircle packedCircle39;
 extern const AbCircle circle40;
+extern const AbPackedCircle packedCircle40;
 extern const AbCircle circle41;
+extern const AbPackedCircle packedCircle41;
 extern const AbCircle circle42;
+extern const AbPackedCircle packedCircle42;
 extern const AbCircle circle43;
+extern const AbPackedCircle packedCircle43;
 extern const AbCircle circle44;
+extern const AbPackedCircle packedCircle44;
 extern const AbCircle circle45;
+extern const AbPackedCircle packedCircle45;
 extern const AbCircle circle46;
+extern const AbPackedCircle packedCircle46;
 extern const AbCircle circle47;
+extern const AbPackedCircle packedCircle47;
 extern const AbCircle circle48;
+extern const AbPackedCircle packedCircle48;
 extern const AbCircle circle49;
+extern const AbPackedCircle packedCircle49;
 extern const AbCircle circle50;
+extern const AbPackedCircle packedCircle50;
 extern const AbCircle circle51;
+extern const AbPackedCircle packedCircle51;
 extern const AbCircle circle52;
+extern const AbPackedCircle packedCircle52;
 extern const AbCircle circle53;
+extern const AbPackedCircle packedCircle53;
 extern const AbCircle circle54;
+extern const AbPackedCircle packedCircle54;
 extern const AbCircle circle55;
+extern const AbPackedCircle packedCircle55;
 extern const AbCircle circle56;
+extern const AbPackedCircle packedCircle56;
 extern const AbCircle circle57;
+extern const AbPackedCircle packedCircle57;
 extern const AbCircle circle58;
+extern const AbPackedCircle packedCircle58;
 extern const AbCircle circle59;
+extern const AbPackedCircle packedCircle59;
 extern const AbCircle circle60;
+extern const AbPackedCircle packedCircle60;
 extern const AbCircle circle61;
+extern const AbPackedCircle packedCircle61;
 extern const AbCircle circle62;
+extern const AbPackedCircle packedCircle62;
 extern const AbCircle circle63;
+extern const AbPackedCircle packedCircle63;
 extern const AbCircle circle64;
+extern const AbPackedCircle packedCircle64;
 extern const AbCircle circle65;
+extern const AbPackedCircle packedCircle65;
 extern const AbCircle circle66;
+extern const AbPackedCircle packedCircle66;
 extern const AbCircle circle67;
+extern const AbPackedCircle packedCircle67;
 extern const AbCircle circle68;
+extern const AbPackedCircle packedCircle68;
 extern const AbCircle circle69;
+extern const AbPackedCircle packedCircle69;
 extern const AbCircle circle70;
+extern const AbPackedCircle packedCircle70;
 extern const AbCircle circle71;
+extern const AbPackedCircle packedCircle71;
 extern const AbCircle circle72;
+extern const AbPackedCircle packedCircle72;
 extern const AbCircle circle73;
+extern const AbPackedCircle packedCircle73;
 extern const AbCircle circle74;
+extern const AbPackedCircle packedCircle74;
 extern const AbCircle circle75;
+extern const AbPackedCircle packedCircle75;
 extern const AbCircle circle76;
+extern const AbPackedCircle packedCircle76;
 extern const AbCircle circle77;
+extern const AbPackedCircle packedCircle77;
 extern const AbCircle circle78;
+extern const AbPackedCircle packedCircle78;
 extern const AbCircle circle79;
+extern const AbPackedCircle packedCircle79;
 extern const AbCircle circle80;
+extern const AbPackedCircle packedCircle80;
 extern const AbCircle circle81;
+extern const AbPackedCircle packedCircle81;
 extern const AbCircle circle82;
+extern const AbPackedCircle packedCircle82;
 extern const AbCircle circle83;
+extern const AbPackedCircle packedCircle83;
 extern const AbCircle circle84;
+extern const AbPackedCircle packedCircle84;
 extern const AbCircle circle85;
+extern const AbPackedCircle packedCircle85;
 extern const AbCircle circle86;
+extern const AbPackedCircle packedCircle86;
 extern const AbCircle circle87;
+extern const AbPackedCircle packedCircle87;
 extern const AbCircle circle88;
+extern const AbPackedCircle packedCircle88;
 extern const AbCircle circle89;
+extern const AbPackedCircle packedCircle89;
 extern const AbCircle circle90;
+extern const AbPackedCircle packedCircle90;
 extern const AbCircle circle91;
+extern const AbPackedCircle packedCircle91;
 extern const AbCircle circle92;
+extern const AbPackedCircle packedCircle92;
 extern const AbCircle circle93;
+extern const AbPackedCircle packedCircle93;
 extern const AbCircle circle94;
+extern const AbPackedCircle packedCircle94;
 extern const AbCircle circle95;
+extern const AbPackedCircle packedCircle95;
 extern const AbCircle circle96;
+extern const AbPackedCircle packedCircle96;
 extern const AbCircle circle97;
+extern const AbPackedCircle packedCircle97;
 extern const AbCircle circle98;
+extern const AbPackedCircle packedCircle98;
 extern const AbCircle circle99;
+extern const AbPackedCircle packedCircle99;
 extern const AbCircle circle100;
+extern const AbPackedCircle packedCircle100;
 extern const AbCircle circle101;
+extern const AbPackedCircle packedCircle101;
 extern const AbCircle circle102;
+extern const AbPackedCircle packedCircle102;
 extern const AbCircle circle103;
+extern const AbPackedCircle packedCircle103;
 extern const AbCircle circle104;
+extern const AbPackedCircle packedCircle104;
 extern const AbCircle circle105;
+extern const AbPackedCircle packedCircle105;
 extern const AbCircle circle106;
+extern const AbPackedCircle packedCircle106;
 extern const AbCircle circle107;
+extern const AbPackedCircle packedCircle107;
 extern const AbCircle circle108;
+extern const AbPackedCircle packedCircle108;
 extern const AbCircle circle109;
+extern const AbPackedCircle packedCircle109;
 extern const AbCircle circle110;
+extern const AbPackedCircle packedCircle110;
 extern const AbCircle circle111;
+extern const AbPackedCircle packedCircle111;
 extern const AbCircle circle112;
+extern const AbPackedCircle packedCircle112;
 extern const AbCircle circle113;
+extern const AbPackedCircle packedCircle113;
 extern const AbCircle circle114;
+extern const AbPackedCircle packedCircle114;
 extern const AbCircle circle115;
+extern const AbPackedCircle packedCircle115;
 extern const AbCircle circle116;
+extern const AbPackedCircle packedCircle116;
 extern const AbCircle circle117;
+extern const AbPackedCircle packedCircle117;
 extern const AbCircle circle118;
+extern const AbPackedCircle packedCircle118;
 extern const AbCircle circle119;
+extern const AbPackedCircle packedCircle119;
 extern const AbCircle circle120;
+extern const AbPackedCircle packedCircle120;
 extern const AbCircle circle121;
+extern const AbPackedCircle packedCircle121;
 extern const AbCircle circle122;
+extern const AbPackedCircle packedCircle122;
 extern const AbCircle circle123;
+extern const AbPackedCircle packedCircle123;
 extern const AbCircle circle124;
+extern const AbPackedCircle packedCircle124;
 extern const AbCircle circle125;
+extern const AbPackedCircle packedCircle125;
 extern const AbCircle circle126;
+extern const AbPackedCircle packedCircle126;
 extern const AbCircle circle127;
+extern const AbPackedCircle packedCircle127;
 extern const AbCircle circle128;
+extern const AbPackedCircle packedCircle128;
 extern const AbCircle circle129;
+extern const AbPackedCircle packedCircle129;
 extern const AbCircle circle130;
+extern const AbPackedCircle packedCircle130;
 extern const AbCircle circle131;
+extern const AbPackedCircle packedCircle131;
 extern const AbCircle circle132;
+extern const AbPackedCircle packedCircle132;
 extern const AbCircle circle133;
+extern const AbPackedCircle packedCircle133;
 extern const AbCircle circle134;
+extern const AbPackedCircle packedCircle134;
 extern const AbCircle circle135;
+extern const AbPackedCircle packedCircle135;
 extern const AbCircle circle136;
+extern const AbPackedCircle packedCircle136;
 extern const AbCircle circle137;
+extern const AbPackedCircle packedCircle137;
 extern const AbCircle circle138;
+extern const AbPackedCircle packedCircle138;
 extern const AbCircle circle139;
+extern const AbPackedCircle packedCircle139;
 extern const AbCircle circle140;
+extern const AbPackedCircle packedCircle140;
 extern const AbCircle circle141;
+extern const AbPackedCircle packedCircle141;
 extern const AbCircle circle142;
+extern const AbPackedCircle packedCircle142;
 extern const AbCircle circle143;
+extern const AbPackedCircle packedCircle143;
 extern const AbCircle circle144;
+extern const AbPackedCircle packedCircle144;
 extern const AbCircle circle145;
+extern const AbPackedCircle packedCircle145;
 extern const AbCircle circle146;
+extern const AbPackedCircle packedCircle146;
 extern const AbCircle circle147;
+extern const AbPackedCircle packedCircle147;
 extern const AbCircle circle148;
+extern const AbPackedCircle packedCircle148;
 extern const AbCircle circle149;
+extern const AbPackedCircle packedCircle149;
 extern const AbCircle circle150;
+extern const AbPackedCircle packedCircle150;
+
+extern const AbChords capsule14x3;
+extern const AbChords ellipse20x10;
+extern const AbChords rrect20x12r4;
+extern const AbChords ring15x10;
 
 #endif // included 
@@ -0,0 +1,69 @@
+#include "shape.h"
+#include "_abCircle.h"
+
+void
+chordCacheInit(ChordCache *cache, ChordSlot *slots, u_char numSlots,
+	       u_char *store, u_char maxRadius)
+{
+  u_char i;
+  cache->slots = slots;
+  cache->numSlots = numSlots;
+  cache->maxRadius = maxRadius;
+  cache->clock = 0;
+  for (i = 0; i < numSlots; i++, store += maxRadius + 1) {
+    slots[i].radius = slots[i].pins = 0;
+    slots[i].used = 0;
+    slots[i].chords = store;
+  }
+}
+
+const u_char *
+chordCacheGet(ChordCache *cache, u_char radius)
+{
+  ChordSlot *s = cache->slots, *end = s + cache->numSlots, *victim = 0;
+  if (radius == 0 || radius > cache->maxRadius)
+    return 0;
+  for (; s < end; s++) {
+    if (s->radius == radius)	/* hit */
+      break;
+    if (!s->pins && (!victim || s->used < victim->used))
+      victim = s;		/* least recently used (empty slots are 0) */
+  }
+  if (s == end) {		/* miss */
+    if (!victim)
+      return 0;
+    s = victim;
+    computeChordVec(s->chords, radius);
+    s->radius = radius;
+  }
+  s->pins++;
+  s->used = ++cache->clock;
+  return s->chords;
+}
+
+void
+chordCacheRelease(ChordCache *cache, const u_char *chords)
+{
+  ChordSlot *s = cache->slots, *end = s + cache->numSlots;
+  for (; s < end; s++)
+    if (s->chords == chords && s->pins) {
+      s->pins--;
+      return;
+    }
+}
+
+int
+abDynCircleSetRadius(AbDynCircle *circle, ChordCache *cache, u_char radius)
+{
+  const u_char *chords;
+  if (circle->chords && circle->radius == radius)
+    return 1;
+  chords = chordCacheGet(cache, radius);
+  if (!chords)
+    return 0;
+  if (circle->chords)
+    chordCacheRelease(cache, circle->chords);
+  circle->chords = chords;
+  circle->radius = radius;
+  return 1;
+}
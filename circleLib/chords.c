@@ -0,0 +1,58 @@
+#include "shape.h"
+#include "_abCircle.h"
+
+void
+abChordsGetBounds(const AbChords *shape, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft.axes[0] = centerPos->axes[0] - shape->halfWidth;
+  bounds->topLeft.axes[1] = centerPos->axes[1] - shape->halfHeight;
+  bounds->botRight.axes[0] = centerPos->axes[0] + shape->halfWidth;
+  bounds->botRight.axes[1] = centerPos->axes[1] + shape->halfHeight;
+}
+
+// true if pixel is in shape centered at centerPos
+int
+abChordsCheck(const AbChords *shape, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  Vec2 relPos;
+  u_char hole;
+  vec2Sub(&relPos, pixel, centerPos); /* vector from center to pixel */
+  vec2Abs(&relPos);		      /* project to first quadrant */
+  if (relPos.axes[1] > shape->halfHeight || relPos.axes[0] > shape->outer[relPos.axes[1]])
+    return 0;
+  hole = shape->inner ? shape->inner[relPos.axes[1]] : CHORD_NONE;
+  return hole == CHORD_NONE || relPos.axes[0] > hole;
+}
+
+// like abChordsCheck, also finding the end of the run containing pixel
+int
+abChordsSpan(const AbChords *shape, const Vec2 *centerPos, const Vec2 *pixel,
+	     int *runEnd, u_int *color)
+{
+  int dRow = pixel->axes[1] - centerPos->axes[1];
+  int col = pixel->axes[0], center = centerPos->axes[0];
+  int halfWidth;
+  u_char hole;
+  if (dRow < 0)
+    dRow = -dRow;
+  if (dRow > shape->halfHeight || col > center + (halfWidth = shape->outer[dRow])) {
+    *runEnd = SPAN_END;		/* never within on this row */
+    return 0;
+  } else if (col < center - halfWidth) {
+    *runEnd = center - halfWidth - 1;
+    return 0;
+  }
+  hole = shape->inner ? shape->inner[dRow] : CHORD_NONE;
+  if (hole == CHORD_NONE) {
+    *runEnd = center + halfWidth;
+    return 1;
+  } else if (col < center - hole) { /* left of hole */
+    *runEnd = center - hole - 1;
+    return 1;
+  } else if (col <= center + hole) { /* within hole */
+    *runEnd = center + hole;
+    return 0;
+  }
+  *runEnd = center + halfWidth;
+  return 1;
+}
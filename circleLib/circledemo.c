@@ -3,24 +3,25 @@
 #include <lcddraw.h>
 #include "abCircle.h"
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, {10,10}};; /**< 10x10 rectangle */
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectSpan, {10,10}};; /**< 10x10 rectangle */
+
+const LayerDesc redSquareDesc = {(const AbShape *)&rect10, COLOR_RED, 1};
+const LayerDesc orangeCircleDesc = {(const AbShape *)&circle14, COLOR_ORANGE, 0};
 
 u_int bgColor = COLOR_BLUE;
 
 
 Layer layer1 = {		/**< Layer with a red square */
-  (AbShape *)&rect10,
+  &redSquareDesc,
   {screenWidth/2, screenHeight/2}, /**< center */
   {0,0}, {0,0},				    /* next & last pos */
-  COLOR_RED,
   0
 };
 
 Layer layer0 = {		/**< Layer with an orange circle */
-  (AbShape *)&circle14,
+  &orangeCircleDesc,
   {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
   {0,0}, {0,0},				    /* next & last pos */
-  COLOR_ORANGE,
   &layer1,
 };
 
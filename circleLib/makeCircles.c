@@ -1,50 +1,160 @@
 
-///////////////////////////////////////////
-// build table chordVec[d] of circle 1/2 widths at distances d from center
-// Code adapted from RobG's EduKit
-// Uses Bresenham's circle algorithm
-// Modified from RobG's EduKit by Eric Freudenthal and David Pruitt 2016
-///////////////////////////////////////////
-void computeChordVec(unsigned char chordVec[], unsigned char radius) 
+#include "stdio.h"
+#include "assert.h"
+
+void computeChordVec(unsigned char chordVec[], unsigned char radius); /* computeChordVec.c */
+
+#define CHORD_NONE 0xff		/* as in _abCircle.h */
+
+// half width of row d of an ellipse with half-axes a (cols) and b (rows),
+// or -1 if the row is outside it.  A pixel is inside if its center is within 
+// the ellipse with half-axes a+1/2 and b+1/2 (scaled by 2 to stay in integers)
+int ellipseHalf(int a, int b, int d)
+{
+  long long aa = (2*a+1)*(2*a+1), bb = (2*b+1)*(2*b+1);
+  int x;
+  if (d > b)
+    return -1;
+  for (x = a; x >= 0; x--)
+    if (4LL*x*x*bb + 4LL*d*d*aa <= aa*bb)
+      return x;
+  return 0;
+}
+
+// Compute per-row half widths (outer) and hole half widths (inner,
+// CHORD_NONE if none) of the shape named by spec.  Returns the number of
+// rows (halfHeight+1), 0 for a bad spec; *halfWidth gets the shape's half width
+int computeChords(const char *spec, unsigned char outer[], unsigned char inner[], 
+		  int *halfWidth, int *hasHole)
+{
+  int w, h, r, d, rows;
+  char extra;
+  *hasHole = 0;
+  if (sscanf(spec, "ellipse%dx%d%c", &w, &h, &extra) == 2 && w > 0 && h > 0) {
+    for (d = 0; d <= h; d++)
+      outer[d] = ellipseHalf(w, h, d);
+    rows = h + 1;
+  } else if (sscanf(spec, "capsule%dx%d%c", &w, &r, &extra) == 2 && r > 0 && w >= r) {
+    for (d = 0; d <= r; d++)	/* straight sides plus semicircular ends */
+      outer[d] = w - r + ellipseHalf(r, r, d);
+    rows = r + 1;
+  } else if (sscanf(spec, "rrect%dx%dr%d%c", &w, &h, &r, &extra) == 3 &&
+	     r > 0 && w >= r && h >= r) {
+    for (d = 0; d <= h; d++)	/* quarter circle corners */
+      outer[d] = d <= h - r ? w : w - r + ellipseHalf(r, r, d - (h - r));
+    rows = h + 1;
+  } else if (sscanf(spec, "ring%dx%d%c", &w, &r, &extra) == 2 && r >= 0 && w > r) {
+    for (d = 0; d <= w; d++) {	/* outer circle w, hole of radius r */
+      outer[d] = ellipseHalf(w, w, d);
+      inner[d] = d <= r ? ellipseHalf(r, r, d) : CHORD_NONE;
+    }
+    *hasHole = 1;
+    rows = w + 1;
+  } else
+    return 0;
+  if (w > 150 || rows > 151)
+    return 0;
+  *halfWidth = w;
+  return rows;
+}
+
+// write one chord table
+void printChords(FILE *fp, const char *name, const unsigned char chords[], int rows)
+{
+  int d;
+  fprintf(fp, "static const unsigned char %s[%d] = {\n", name, rows);
+  for (d = 0; d < rows; d++) 
+    fprintf(fp, "    %d, // dist from center = %d\n", chords[d], d);
+  fprintf(fp, "};\n\n");
+}
+
+// Write packedCircleN.c: chordVec's row 1/2 widths, encoded as 2-bit deltas
+// (PACKED_ESCAPE codes take the delta from the next escape byte) with an
+// absolute width every PACKED_ROWS rows.  See AbPackedCircle in _abCircle.h
+#define PACKED_ROWS 16		/* as in _abCircle.h */
+#define PACKED_ESCAPE 3
+void makePackedCircle(const unsigned char chordVec[], int radius)
 {
-  int col = radius, row = 0;	/* first coordinate (radius, 0) */
-  
-  // key insight: (col+1)**2 - col**2 = 2col+1
-  
-  int dColSquared = 2 * col - 1;  // change in col**2 for a unit decrease in col
-  int dRowSquared = 1;	    // change in row**2 for a unit increase in row
-
-  int radiusSqErr = 0;		/* (radius, 0) is on the circle  */
-  int colPrev = 0;		/* initially bogus value  to force first entry*/
-  while (col >= row) {		/* only sweep first octant */
-    chordVec[row] = col;      /* row always changes in first octant */
-
-    /* mirror into 2nd octant */
-    if (colPrev != col)		/* col sometimes repeats in first octant */
-      chordVec[col] = row;	/* only save first (max) col for row */
-    colPrev = col;
-
-    row++;			/* move vertically (slope <= -1 for first octant) */
-    radiusSqErr += dRowSquared;	/* current radiusSqErr */
-    dRowSquared += 2; 		/* next dRowSquared */
-    if ((2 * radiusSqErr) > dColSquared) { /* only update col if error reduced */
-      col--;			/* move horizontally */
-      radiusSqErr -= dColSquared;	/* current radiusSqErr */
-      dColSquared -= 2;	      /* next dColSquared */
+  unsigned char halfWidth[151], codes[38] = {0}, escapes[151];
+  int row, col, numEscapes = 0;
+  char filename[100];
+  FILE *fp;
+  for (row = 0; row <= radius; row++) { /* widest col with chordVec[col] >= row */
+    for (col = radius; chordVec[col] < row; col--)
+      ;
+    halfWidth[row] = col;
+  }
+  sprintf(filename, "circles/packedCircle%d.c", radius);
+  fp = fopen(filename, "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeCircles.\n");
+  fprintf(fp, "#include \"abCircle.h\"\n\n");
+  fprintf(fp, "static const unsigned char checkpoints[%d][2] = {\n", radius / PACKED_ROWS + 1);
+  for (row = 0; row <= radius; row++) {
+    int delta = row ? halfWidth[row-1] - halfWidth[row] : 0, code = delta;
+    assert(delta >= 0);
+    if (delta >= PACKED_ESCAPE) {
+      code = PACKED_ESCAPE;
+      escapes[numEscapes++] = delta;
     }
+    codes[row / 4] |= code << (2 * (row % 4));
+    if (row % PACKED_ROWS == 0)	/* width & escapes used so far */
+      fprintf(fp, "    {%d, %d}, // dist from center = %d\n", halfWidth[row], numEscapes, row);
   }
+  fprintf(fp, "};\n\n");
+  fprintf(fp, "static const unsigned char codes[%d] = {", radius / 4 + 1);
+  for (row = 0; row <= radius / 4; row++)
+    fprintf(fp, "%s0x%02x,", row % 12 ? " " : "\n    ", codes[row]);
+  fprintf(fp, "\n};\n\n");
+  fprintf(fp, "static const unsigned char escapes[%d] = {", numEscapes ? numEscapes : 1);
+  for (row = 0; row < numEscapes; row++)
+    fprintf(fp, "%s%d,", row % 12 ? " " : "\n    ", escapes[row]);
+  fprintf(fp, "\n};\n\n");
+  fprintf(fp, "static PackedCursor cursor = {0, %d, 0};\n\n", radius);
+  fprintf(fp, "const AbPackedCircle packedCircle%d = {", radius);
+  fprintf(fp, "  abPackedCircleGetBounds, abPackedCircleCheck, abPackedCircleSpan, "
+	  "codes, escapes, checkpoints, &cursor, %d", radius);
+  fprintf(fp, "};\n");
+  fclose(fp);
 }
 
-#include "stdio.h"
-#include "assert.h"
+// Generate chord shape named spec (e.g. capsule14x3) as a source file
+int makeChordShape(const char *spec, FILE *circleIncludeFile)
+{
+  unsigned char outer[151], inner[151];
+  int rows, halfWidth, hasHole;
+  char filename[100];
+  FILE *fp;
+  rows = computeChords(spec, outer, inner, &halfWidth, &hasHole);
+  if (!rows) {
+    fprintf(stderr, "makeCircles: bad shape \"%s\" (expected ellipseWxH, capsuleWxR, "
+	    "rrectWxHrR or ringRxI)\n", spec);
+    return 0;
+  }
+  sprintf(filename, "circles/%s.c", spec);
+  fp = fopen(filename, "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeCircles.\n");
+  fprintf(fp, "#include \"abCircle.h\"\n\n");
+  printChords(fp, "outer", outer, rows);
+  if (hasHole)
+    printChords(fp, "inner", inner, rows);
+  fprintf(fp, "const AbChords %s = {", spec);
+  fprintf(fp, "  abChordsGetBounds, abChordsCheck, abChordsSpan, outer, %s, %d, %d",
+	  hasHole ? "inner" : "0", halfWidth, rows - 1);
+  fprintf(fp, "};\n");
+  fclose(fp);
+  fprintf(circleIncludeFile, "extern const AbChords %s;\n", spec);
+  return 1;
+}
 
 
-// Generate circles as source files
+// Generate circles, and the chord shapes named on the command line, as source files
 // (c) Eric Freudenthal, 2016
-int main()
+int main(int argc, char **argv)
 {
-  int radius;
-  char chordVec[151];
+  int radius, i;
+  unsigned char chordVec[151];
   FILE *circleIncludeFile = fopen("abCircle_decls.h", "w");
   FILE *chordIncludeFile = fopen("chordVec.h", "w");
   assert(chordIncludeFile); assert(circleIncludeFile);
@@ -80,15 +190,22 @@ int main()
       fprintf(fp, "#include \"abCircle.h\"\n\n");
       fprintf(fp, "#include \"chordVec.h\"\n\n");
       fprintf(fp, "const AbCircle circle%d = {" , radius);
-      fprintf(fp, "  abCircleGetBounds, abCircleCheck, chordVec%d, %d", radius, radius);
+      fprintf(fp, "  abCircleGetBounds, abCircleCheck, abCircleSpan, chordVec%d, %d", radius, radius);
       fprintf(fp, "};\n");
       fclose(fp);
     }
+    makePackedCircle(chordVec, radius); /* packedCircleN.c */
     				/* includes */
     fprintf(chordIncludeFile, "extern const unsigned char chordVec%d[%d];\n", radius, radius+1);
     fprintf(circleIncludeFile, "extern const AbCircle circle%d;\n" , radius);
+    fprintf(circleIncludeFile, "extern const AbPackedCircle packedCircle%d;\n" , radius);
   }
 
+  fprintf(circleIncludeFile, "\n");
+  for (i = 1; i < argc; i++)
+    if (!makeChordShape(argv[i], circleIncludeFile))
+      return 1;
+
   fprintf(circleIncludeFile, "\n#endif // included \n");
   fprintf(chordIncludeFile, "\n#endif // included \n");
   fclose(chordIncludeFile);
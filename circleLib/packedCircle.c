@@ -0,0 +1,72 @@
+#include "shape.h"
+#include "_abCircle.h"
+
+#define packedCode(codes, row) (((codes)[(row) >> 2] >> (((row) & 3) << 1)) & 3)
+
+// half width of circle's row at distance dRow (<= radius) from its center
+static u_char
+packedHalfWidth(const AbPackedCircle *circle, u_char dRow)
+{
+  PackedCursor *c = circle->cursor;
+  u_char code, fromCheckpoint = dRow & (PACKED_ROWS - 1);
+  int toCursor = dRow - c->row;
+  if (toCursor < 0)
+    toCursor = -toCursor;
+  if (fromCheckpoint < toCursor) { /* restart from the checkpoint above dRow */
+    const u_char *cp = circle->checkpoints[dRow / PACKED_ROWS];
+    c->row = dRow - fromCheckpoint;
+    c->halfWidth = cp[0];
+    c->escape = cp[1];
+  }
+  while (c->row < dRow) {	/* step away from center */
+    c->row++;
+    code = packedCode(circle->codes, c->row);
+    c->halfWidth -= code == PACKED_ESCAPE ? circle->escapes[c->escape++] : code;
+  }
+  while (c->row > dRow) {	/* step toward center */
+    code = packedCode(circle->codes, c->row);
+    c->row--;
+    c->halfWidth += code == PACKED_ESCAPE ? circle->escapes[--c->escape] : code;
+  }
+  return c->halfWidth;
+}
+
+void
+abPackedCircleGetBounds(const AbPackedCircle *circle, const Vec2 *centerPos, Region *bounds)
+{
+  u_char axis, radius = circle->radius;
+  for (axis = 0; axis < 2; axis ++) {
+    bounds->topLeft.axes[axis] = centerPos->axes[axis] - radius;
+    bounds->botRight.axes[axis] = centerPos->axes[axis] + radius;
+  }
+}
+
+int
+abPackedCircleCheck(const AbPackedCircle *circle, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  Vec2 relPos;
+  vec2Sub(&relPos, pixel, centerPos); /* vector from center to pixel */
+  vec2Abs(&relPos);		      /* project to first quadrant */
+  return (relPos.axes[1] <= circle->radius &&
+	  relPos.axes[0] <= packedHalfWidth(circle, relPos.axes[1]));
+}
+
+int
+abPackedCircleSpan(const AbPackedCircle *circle, const Vec2 *centerPos, const Vec2 *pixel,
+		   int *runEnd, u_int *color)
+{
+  int dRow = pixel->axes[1] - centerPos->axes[1];
+  int col = pixel->axes[0], center = centerPos->axes[0];
+  int halfWidth;
+  if (dRow < 0)
+    dRow = -dRow;
+  if (dRow > circle->radius || col > center + (halfWidth = packedHalfWidth(circle, dRow))) {
+    *runEnd = SPAN_END;		/* never within on this row */
+    return 0;
+  } else if (col < center - halfWidth) {
+    *runEnd = center - halfWidth - 1;
+    return 0;
+  }
+  *runEnd = center + halfWidth;
+  return 1;
+}
@@ -0,0 +1,88 @@
+/** \file lcdbench.c
+ *  \brief Times fills and redraws in the 16-bit and 12-bit color modes
+ */
+
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+
+#define FILLS 4			/**< full-screen fills per trial */
+#define TEXT_PASSES 2		/**< screens of text per trial */
+
+static unsigned long benchStartTime;
+
+/** Start timing */
+static void benchStart()
+{
+  benchStartTime = timeNow();
+}
+
+/** Milliseconds since benchStart */
+static u_int benchStop()
+{
+  return (timeNow() - benchStartTime) / (clockPlan.smclkHz / 1000);
+}
+
+/** Fill the whole screen FILLS times, then an odd-sized square */
+static u_int benchFill()
+{
+  u_char i;
+  benchStart();
+  for (i = 0; i < FILLS; i++)
+    clearScreen(i & 1 ? COLOR_BLUE : COLOR_RED);
+  fillRectangle(10, 10, 41, 41, COLOR_GREEN);
+  return benchStop();
+}
+
+/** Cover the screen with 5x7 text, one pixel at a time */
+static u_int benchText()
+{
+  u_char pass, col, row;
+  benchStart();
+  for (pass = 0; pass < TEXT_PASSES; pass++)
+    for (row = 0; row + 8 <= screenHeight; row += 8)
+      for (col = 0; col + 6 <= screenWidth; col += 6)
+	drawChar5x7(col, row, 'A' + (col + row + pass) % 26,
+		    COLOR_WHITE, COLOR_BLACK);
+  return benchStop();
+}
+
+/** Decimal ms count right-aligned in 5 chars */
+static void drawMs(u_char col, u_char row, u_int ms)
+{
+  char s[] = "    0ms";
+  char *p = &s[4];
+  do {
+    *p-- = '0' + ms % 10;
+    ms /= 10;
+  } while (ms);
+  drawString5x7(col, row, s, COLOR_GREEN, COLOR_BLACK);
+}
+
+/** Run each benchmark in both color modes, then report the times */
+main()
+{
+  u_int fill16, text16, fill12, text12;
+
+  configureClockPlan(TICK_WDT_SMCLK); /**< SPI at full SMCLK */
+  lcd_init();
+  timeInit();
+  or_sr(0x8);			/**< GIE (enable interrupts) */
+
+  lcd_setColorMode(LCD_COLOR_16);
+  fill16 = benchFill();
+  text16 = benchText();
+  lcd_setColorMode(LCD_COLOR_12);
+  fill12 = benchFill();
+  text12 = benchText();
+
+  clearScreen(COLOR_BLACK);
+  drawString5x7(34, 20, " 16 bit 12 bit", COLOR_WHITE, COLOR_BLACK);
+  drawString5x7(4, 35, "fill", COLOR_WHITE, COLOR_BLACK);
+  drawMs(40, 35, fill16);
+  drawMs(82, 35, fill12);
+  drawString5x7(4, 50, "text", COLOR_WHITE, COLOR_BLACK);
+  drawMs(40, 50, text16);
+  drawMs(82, 50, text12);
+}
@@ -4,6 +4,53 @@
 #include "lcdutils.h"
 #include "lcddraw.h"
 
+typedef struct {
+  u_char colMin, rowMin, colMax, rowMax;
+} ClipRect;
+
+static ClipRect clipStack[LCD_CLIP_DEPTH + 1] = {
+  {0, 0, screenWidth - 1, screenHeight - 1}
+};
+static u_char clipTop = 0;	/**< clipStack[clipTop] is the clip rectangle */
+static u_char clipEmpty = 0;	/**< bit n set if clipStack[n] is empty */
+
+int lcd_pushClip(int colMin, int rowMin, int colMax, int rowMax)
+{
+  ClipRect *c;
+  if (clipTop == LCD_CLIP_DEPTH)
+    return 0;
+  c = &clipStack[clipTop + 1];
+  if (!lcd_clipArea(&colMin, &rowMin, &colMax, &rowMax))
+    clipEmpty |= 1 << (clipTop + 1);
+  else {
+    clipEmpty &= ~(1 << (clipTop + 1));
+    c->colMin = colMin; c->rowMin = rowMin;
+    c->colMax = colMax; c->rowMax = rowMax;
+  }
+  clipTop++;
+  return 1;
+}
+
+void lcd_popClip()
+{
+  if (clipTop)
+    clipTop--;
+}
+
+int lcd_clipArea(int *colMin, int *rowMin, int *colMax, int *rowMax)
+{
+  const ClipRect *c = &clipStack[clipTop];
+  if ((clipEmpty & (1 << clipTop)) ||
+      *colMin > c->colMax || *colMax < c->colMin || /* trivial reject */
+      *rowMin > c->rowMax || *rowMax < c->rowMin)
+    return 0;
+  if (*colMin < c->colMin) *colMin = c->colMin;	/* trim */
+  if (*colMax > c->colMax) *colMax = c->colMax;
+  if (*rowMin < c->rowMin) *rowMin = c->rowMin;
+  if (*rowMax > c->rowMax) *rowMax = c->rowMax;
+  return 1;
+}
+
 
 /** Draw single pixel at x,row 
  *
@@ -11,8 +58,11 @@
  *  \param row Row to draw to
  *  \param colorBGR Color of pixel in BGR
  */
-void drawPixel(u_char col, u_char row, u_int colorBGR) 
+void drawPixel(int col, int row, u_int colorBGR) 
 {
+  int colMax = col, rowMax = row;
+  if (!lcd_clipArea(&col, &row, &colMax, &rowMax))
+    return;
   lcd_setArea(col, row, col, row);
   lcd_writeColor(colorBGR);
 }
@@ -25,26 +75,20 @@ void drawPixel(u_char col, u_char row, u_int colorBGR)
  *  \param height height of rectangle
  *  \param colorBGR Color of rectangle in BGR
  */
-void fillRectangle(u_char colMin, u_char rowMin, u_char width, u_char height, 
+void fillRectangle(int colMin, int rowMin, int width, int height, 
 		   u_int colorBGR)
 {
-  u_char colLimit = colMin + width, rowLimit = rowMin + height;
-  lcd_setArea(colMin, rowMin, colLimit - 1, rowLimit - 1);
-  u_int total = width * height;
-  u_int c = 0;
-  while ((c++) < total) {
-    lcd_writeColor(colorBGR);
-  }
+  int colMax = colMin + width - 1, rowMax = rowMin + height - 1;
+  if (width <= 0 || height <= 0 || !lcd_clipArea(&colMin, &rowMin, &colMax, &rowMax))
+    return;
+  lcd_setArea(colMin, rowMin, colMax, rowMax);
+  lcd_writeColorRun(colorBGR, (colMax - colMin + 1) * (rowMax - rowMin + 1));
 }
 
 void fillLine(u_int colorBGR){
 
   lcd_setArea(50, 50, 69, 79);
-  u_int total = 20 * 30;
-  u_int c = 0;
-  while ((c++) < total){
-    lcd_writeColor(colorBGR);
-  }
+  lcd_writeColorRun(colorBGR, 20 * 30);
 
 }
 	      
@@ -64,24 +108,26 @@ void clearScreen(u_int colorBGR)
 /** 5x7 font - this function draws background pixels
  *  Adapted from RobG's EduKit
  */
-void drawChar5x7(u_char rcol, u_char rrow, char c, 
+void drawChar5x7(int rcol, int rrow, char c, 
      u_int fgColorBGR, u_int bgColorBGR) 
 {
-  u_char col = 0;
-  u_char row = 0;
-  u_char bit = 0x01;
+  int colMin = rcol, rowMin = rrow, colMax = rcol + 4, rowMax = rrow + 7;
+  u_char col, row, colFirst, colLast;
+  u_char bit;
   u_char oc = c - 0x20;
 
-  lcd_setArea(rcol, rrow, rcol + 4, rrow + 7); /* relative to requested col/row */
-  while (row < 8) {
-    while (col < 5) {
+  if (!lcd_clipArea(&colMin, &rowMin, &colMax, &rowMax))
+    return;
+  lcd_setArea(colMin, rowMin, colMax, rowMax);
+  colFirst = colMin - rcol;	/* visible part, relative to requested col/row */
+  colLast = colMax - rcol;
+  row = rowMin - rrow;
+  bit = 0x01 << row;
+  for (; row <= rowMax - rrow; row++, bit <<= 1) {
+    for (col = colFirst; col <= colLast; col++) {
       u_int colorBGR = (font_5x7[oc][col] & bit) ? fgColorBGR : bgColorBGR;
       lcd_writeColor(colorBGR);
-      col++;
     }
-    col = 0;
-    bit <<= 1;
-    row++;
   }
 }
 
@@ -97,11 +143,12 @@ void drawChar5x7(u_char rcol, u_char rrow, char c,
  *  \param fgColorBGR Foreground color in BGR
  *  \param bgColorBGR Background color in BGR
  */
-void drawString5x7(u_char col, u_char row, char *string,
+void drawString5x7(int col, int row, char *string,
 		u_int fgColorBGR, u_int bgColorBGR)
 {
-  u_char cols = col;
-  while (*string) {
+  int cols = col;
+  const ClipRect *clip = &clipStack[clipTop];
+  while (*string && cols <= clip->colMax) { /* later chars are right of clip */
     drawChar5x7(cols, row, *string++, fgColorBGR, bgColorBGR);
     cols += 6;
   }
@@ -116,7 +163,7 @@ void drawString5x7(u_char col, u_char row, char *string,
  *  \param height Height of rectangle
  *  \param colorBGR Color of rectangle in BGR
  */
-void drawRectOutline(u_char colMin, u_char rowMin, u_char width, u_char height,
+void drawRectOutline(int colMin, int rowMin, int width, int height,
 		     u_int colorBGR)
 {
   /**< top & bot */
@@ -5,13 +5,38 @@
 #ifndef lcddraw_included
 #define lcddraw_included
 
+/** Drawing primitives below only draw within the clip rectangle, which
+ *  is initially the whole screen.  Their coordinates may be negative or
+ *  beyond the screen: draws entirely outside the clip rectangle are 
+ *  skipped, and others are trimmed to it.
+ */
+#define LCD_CLIP_DEPTH 4	/**< maximum nesting of lcd_pushClip */
+
+/** Narrow the clip rectangle to its intersection with the (inclusive)
+ *  rectangle colMin,rowMin - colMax,rowMax, saving the current one.
+ *
+ *  \return 0 (and the clip is unchanged) if LCD_CLIP_DEPTH are already pushed
+ */
+int lcd_pushClip(int colMin, int rowMin, int colMax, int rowMax);
+
+/** Restore the clip rectangle saved by the last lcd_pushClip.
+ */
+void lcd_popClip();
+
+/** Trim the (inclusive) rectangle colMin,rowMin - colMax,rowMax to the 
+ *  clip rectangle.
+ *
+ *  \return 0 if nothing is left
+ */
+int lcd_clipArea(int *colMin, int *rowMin, int *colMax, int *rowMax);
+
 /** Draw single pixel at x,row 
  *
  *  \param col Column to draw to
  *  \param row Row to draw to
  *  \param colorBGR Color of pixel in BGR
  */
-void drawPixel(u_char col, u_char row, u_int colorBGR);
+void drawPixel(int col, int row, u_int colorBGR);
 
 /** Fill rectangle
  *
@@ -21,7 +46,7 @@ void drawPixel(u_char col, u_char row, u_int colorBGR);
  *  \param height height of rectangle
  *  \param colorBGR Color of rectangle in BGR
  */
-void fillRectangle(u_char colMin, u_char rowMin, u_char width, u_char height, u_int colorBGR);
+void fillRectangle(int colMin, int rowMin, int width, int height, u_int colorBGR);
 
 void fillLine(u_int colorBGR);
 
@@ -43,13 +68,13 @@ void clearScreen(u_int colorBGR);
  *  \param fgColorBGR Foreground color in BGR
  *  \param bgColorBGR Background color in BGR
  */
-void drawString5x7(u_char col, u_char row, char *string, 
+void drawString5x7(int col, int row, char *string, 
 		   u_int fgColorBGR, u_int bgColorBGR);
 
 /** 5x7 font - this function draws background pixels
  *  Adapted from RobG's EduKit
  */
-void drawChar5x7(u_char col, u_char row, char c, 
+void drawChar5x7(int col, int row, char c, 
 		 u_int fgColorBGR, u_int bgColorBGR);
 
 /** Draw rectangle outline
@@ -60,7 +85,7 @@ void drawChar5x7(u_char col, u_char row, char c,
  *  \param height Height of rectangle
  *  \param colorBGR Color of rectangle in BGR
  */
-void drawRectOutline(u_char colMin, u_char rowMin, u_char width, u_char height,
+void drawRectOutline(int colMin, int rowMin, int width, int height,
 		     u_int colorBGR);
 #endif // included
 
@@ -13,6 +13,13 @@
 
 u_char _orientation = 0;
 
+void (*lcd_sleepMs)(unsigned int ms) = 0;
+
+static u_char colorMode = LCD_COLOR_16;
+static u_int areaLeft;		/**< pixels left in the area (12-bit mode) */
+static u_char halfPending;	/**< a 12-bit pixel's last nibble is unsent */
+static u_char halfNibble;	/**< ... in the top of this byte */
+
 /** LCD pin definitions*/
 /** SCLK & MOSI*/
 #define LCD_SPI_OUT		P1OUT
@@ -76,6 +83,11 @@ static void setUpSPIforLCD() {
   LCD_SELECT();
 }
 
+unsigned long lcd_spiHz(unsigned long smclkHz)
+{
+  return smclkHz / (UCB0BR0 | UCB0BR1 << 8);
+}
+
 /** Screen dimensions */
 
 /** Write data to LCD */
@@ -92,13 +104,75 @@ typedef union {
   u_int colorBGRWord;
 } ColorBGR;
 
+/** Send the last nibble of a pixel whose partner never came */
+static void flushHalf()
+{
+  lcd_writeData(halfNibble);
+  halfPending = 0;
+}
+
+/** Write a 12-bit pixel.  Pairs of pixels are packed into 3 bytes, so
+ *  the first pixel's low nibble waits for its partner, or for the end
+ *  of the area.
+ */
+static void writeColor12(u_int color12)
+{
+  if (halfPending) {
+    lcd_writeData(halfNibble | color12 >> 8);
+    lcd_writeData(color12);
+    halfPending = 0;
+  } else {
+    lcd_writeData(color12 >> 4);
+    halfNibble = color12 << 4;
+    halfPending = 1;
+  }
+  if (!--areaLeft && halfPending) /* odd-sized area */
+    flushHalf();
+}
+
 void lcd_writeColor(u_int colorBGR)
 {
   ColorBGR colorU = {.colorBGRWord = colorBGR};
+  if (colorMode == LCD_COLOR_12) {
+    writeColor12(bgr2color12(colorBGR));
+    return;
+  }
   lcd_writeData(colorU.colorBytes[1]);
   lcd_writeData(colorU.colorBytes[0]);
 }
 
+void lcd_writeColorRun(u_int colorBGR, u_int count)
+{
+  ColorBGR colorU = {.colorBGRWord = colorBGR};
+  u_int color12;
+  u_char b0, b1, b2;
+  if (colorMode == LCD_COLOR_16) {
+    while (count--) {
+      lcd_writeData(colorU.colorBytes[1]);
+      lcd_writeData(colorU.colorBytes[0]);
+    }
+    return;
+  }
+  if (!count)
+    return;
+  color12 = bgr2color12(colorBGR);
+  if (halfPending) {		/* complete the pending pair */
+    writeColor12(color12);
+    count--;
+  }
+  b0 = color12 >> 4;		/* a pair of this color */
+  b1 = color12 << 4 | color12 >> 8;
+  b2 = color12;
+  areaLeft -= count & ~1;
+  for (; count > 1; count -= 2) {
+    lcd_writeData(b0);
+    lcd_writeData(b1);
+    lcd_writeData(b2);
+  }
+  if (count)
+    writeColor12(color12);
+}
+
 /** Write command to LCD (private) */
 void _writeCommand(u_char command) 
 {
@@ -115,9 +189,22 @@ void _delay(u_char x10ms) {
 	}
 }
 
+/** Wait x10ms, sleeping if lcd_sleepMs is set (private) */
+static void lcd_wait(u_char x10ms)
+{
+  if (lcd_sleepMs)
+    lcd_sleepMs(x10ms * 10);
+  else
+    _delay(x10ms);
+}
+
 /** Set area to draw to */
 void lcd_setArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd) 
 {
+	if (halfPending)	/* previous area was left incomplete */
+		flushHalf();
+	if (colorMode == LCD_COLOR_12)
+		areaLeft = (colEnd - colStart + 1) * (rowEnd - rowStart + 1);
 	_writeCommand(CASETP);
 	lcd_writeData(0);
 	lcd_writeData(colStart);
@@ -131,16 +218,25 @@ void lcd_setArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd)
 	_writeCommand(RAMWRP);
 }
 
+void lcd_setColorMode(u_char mode)
+{
+  if (halfPending)		/* finish the open area in the old mode */
+    flushHalf();
+  areaLeft = 0;			/* COLMOD ends the RAM write: set a new area */
+  _writeCommand(COLMOD);
+  lcd_writeData(mode == LCD_COLOR_12 ? 0x03 : 0x05);
+  colorMode = mode;
+}
+
 /** Initialize onboard LCD */
 void lcd_init() 
 {
   setUpSPIforLCD();
   _writeCommand(SWRESET);  /**< software reset */
-  _delay(20);
+  lcd_wait(20);
   _writeCommand(SLEEPOUT); /**< exit sleep */
-  _delay(20);
-  _writeCommand(COLMOD);   /**< Set Color Format 16bit */
-  lcd_writeData(0x05);
+  lcd_wait(20);
+  lcd_setColorMode(LCD_COLOR_MODE); /**< Set Color Format */
   _writeCommand(DISPON);   /**< display ON */
 
   _writeCommand(MADCTL);
@@ -0,0 +1,48 @@
+/** \file profileDraw.c
+ *  \brief On-screen overlay for the frame profiler (see profile.h)
+ */
+#include <libTimer.h>
+#include <profile.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+
+/** Append n right-aligned in width chars, then a space */
+static char *putNum(char *p, u_int n, u_char width)
+{
+  char *end = p + width;
+  p = end;
+  do {
+    *--p = '0' + n % 10;
+    n /= 10;
+  } while (n && p > end - width);
+  while (p > end - width)
+    *--p = ' ';
+  *end = ' ';
+  return end + 1;
+}
+
+void profileDraw(int col, int row, u_int fgColorBGR, u_int bgColorBGR)
+{
+  char s[6 + 3 * PROFILE_STAGES + 1]; /* "NNNms" then "NN" per stage */
+  char *p = s;
+  unsigned long total = 0, stage[PROFILE_STAGES] = {0};
+  u_char i, j;
+  for (j = 0; j < PROFILE_FRAMES; j++) {
+    total += profileRing[j].total;
+    for (i = 0; i < PROFILE_STAGES; i++)
+      stage[i] += profileRing[j].stage[i];
+  }
+  if (!total)
+    return;
+  /* average ms = units * 2^PROFILE_SHIFT / (cycles per ms) / frames */
+  p = putNum(p, ((total << PROFILE_SHIFT) / (clockPlan.smclkHz / 1000)) / PROFILE_FRAMES, 3);
+  p[-1] = 'm';
+  *p++ = 's';
+  *p++ = ' ';
+  for (i = 0; i < PROFILE_STAGES; i++) {
+    u_int percent = stage[i] * 100 / total;
+    p = putNum(p, percent > 99 ? 99 : percent, 2);
+  }
+  p[-1] = 0;
+  drawString5x7(col, row, s, fgColorBGR, bgColorBGR);
+}
@@ -1,4 +1,5 @@
 #include <msp430.h>
+#include <libTimer.h>
 #include "p2switches.h"
 
 static unsigned char switch_mask;
@@ -34,8 +35,10 @@ p2sw_init(unsigned char mask)
 unsigned int 
 p2sw_read() {
   unsigned int sw_changed = switches_current ^ switches_last_reported;
+  unsigned int sr = critical_enter(); /* Port_2 also updates P2IES */
   switches_last_reported = switches_current;
   switch_update_interrupt_sense();
+  critical_exit(sr);
   return switches_current /*| (sw_changed << 8)*/;
 }
 
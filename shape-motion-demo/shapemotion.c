@@ -2,6 +2,9 @@
  *  \brief This is a simple shape motion demo.
  *  This demo creates two layers containing shapes.
  *  One layer contains a rectangle and the other a circle.
+ *  A violet circle and an arrow move together as a layer group.
+ *  Pressing S1 launches a puck from a layer pool; once the
+ *  pool is full, each launch first removes the oldest puck.
  *  While the CPU is running the green LED is on, and
  *  when the screen does not need to be redrawn the CPU
  *  is turned off along with the green LED.
@@ -17,137 +20,105 @@
 #define GREEN_LED BIT6
 
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, {10,10}}; /**< 10x10 rectangle */
-AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, 8};
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectSpan, {10,10}}; /**< 10x10 rectangle */
+const AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, 0, 8};
 
-AbRectOutline fieldOutline = {	/* playing field */
-  abRectOutlineGetBounds, abRectOutlineCheck,   
+const AbRectOutline fieldOutline = {	/* playing field */
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineSpan,  
   {screenWidth/2 - 10, screenHeight/2 - 10}
 };
 
-Layer layer4 = {
-  (AbShape *)&rightArrow,
-  {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
-  {(screenWidth/2)+10, (screenHeight/2)+5}, 
-  COLOR_PINK,
+/* layer descriptors are read-only and live in flash */
+const LayerDesc arrowDesc = {(const AbShape *)&rightArrow, COLOR_PINK, 4};
+const LayerDesc violetCircleDesc = {(const AbShape *)&circle8, COLOR_VIOLET, 3};
+const LayerDesc fieldDesc = {(const AbShape *)&fieldOutline, COLOR_BLACK, 2};
+const LayerDesc redSquareDesc = {(const AbShape *)&rect10, COLOR_RED, 1};
+const LayerDesc orangeCircleDesc = {(const AbShape *)&circle14, COLOR_ORANGE, 0};
+const LayerDesc puckDesc = {(const AbShape *)&circle5, COLOR_YELLOW, 1};
+
+/* the violet circle and arrow are a group, so they move as one */
+Layer shipArrow = {		/**< arrow pointing right, off the circle */
+  &arrowDesc,
+  {16, 0},			/**< relative to the group */
+  {0,0}, {0,0},				    /* last & next pos */
   0
 };
-  
 
-Layer layer3 = {		/**< Layer with an orange circle */
-  (AbShape *)&circle8,
+Layer shipCircle = {		/**< violet circle at the group's center */
+  &violetCircleDesc,
+  {0, 0},
+  {0,0}, {0,0},				    /* last & next pos */
+  &shipArrow
+};
+
+LayerGroup ship = {&shipCircle};	/**< bounds set by layerGroupUpdate */
+const LayerDesc shipDesc = {0, 0, 3, &ship};
+
+Layer shipLayer = {		/**< Layer rendering the group */
+  &shipDesc,
   {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
-  {(screenWidth/2)+10, (screenHeight/2)+5}, 
-  COLOR_VIOLET,
-  &layer4,
+  {0,0}, {0,0},				    /* last & next pos */
+  0
 };
 
 
 Layer fieldLayer = {		/* playing field as a layer */
-  (AbShape *) &fieldOutline,
+  &fieldDesc,
   {screenWidth/2, screenHeight/2},/**< center */
-  {screenWidth/2, screenHeight/2}, 
-  COLOR_BLACK,
-  &layer3
+  {0,0}, {0,0},				    /* last & next pos */
+  &shipLayer
 };
 
 Layer layer1 = {		/**< Layer with a red square */
-  (AbShape *)&rect10,
+  &redSquareDesc,
   {screenWidth/2, screenHeight/2}, /**< center */
-  {screenWidth/2, screenHeight/2}, 
-  COLOR_RED,
+  {0,0}, {0,0},				    /* last & next pos */
   &fieldLayer,
 };
 
 Layer layer0 = {		/**< Layer with an orange circle */
-  (AbShape *)&circle14,
+  &orangeCircleDesc,
   {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
-  {(screenWidth/2)+10, (screenHeight/2)+5}, 
-  COLOR_ORANGE,
+  {0,0}, {0,0},				    /* last & next pos */
   &layer1,
 };
 
-/** Moving Layer
- *  Linked list of layer references
- *  Velocity represents one iteration of change (direction & magnitude)
- */
-typedef struct MovLayer_s {
-  Layer *layer;
-  Vec2 velocity;
-  struct MovLayer_s *next;
-} MovLayer;
-
-MovLayer ml3 = { &layer3, {1,1}, 0 }; /**< not all layers move */
-MovLayer ml1 = { &layer1, {1,2}, &ml3 }; 
-MovLayer ml0 = { &layer0, {2,1}, &ml1 }; 
+#define PUCKS 3			/**< pucks in play at once */
+static PoolSlot puckSlots[PUCKS];
+LayerPool pool;			/**< all layers, including pucks */
 
+MOTION_SET(movers, 3 + PUCKS);	/**< not all layers move */
 
-void
-movLayerDraw(MovLayer *movLayers, Layer *layers)
-{
-  int row, col;
-  MovLayer *movLayer;
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
-    Layer *boundLayer = movLayer->layer; /* bounds of moving layer */
-    Region bounds;		
-    layerGetBounds(boundLayer, &bounds);
-    lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], 
-		bounds.botRight.axes[0], bounds.botRight.axes[1]);
-    for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-      for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-	Vec2 pixelPos = {col, row};
-	u_int color = bgColor;
-	Layer *probeLayer;
-	for (probeLayer = layers; probeLayer; 
-	     probeLayer = probeLayer->next) { /* probe all layers, in order */
-	  if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	    color = probeLayer->color;
-	    break; 
-	  } /* if probe check */
-	} // for checking all layers at col, row
-	lcd_writeColor(color); 
-      } // for col
-    } // for row
-  } // for moving layer being updated
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) {
-    Layer *boundLayer = movLayer->layer;
-    boundLayer->dispPos = boundLayer->pos;
-  }
-}	  
+//Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}}; /**< Create a fence region */
 
+u_int bgColor = COLOR_BLUE;     /**< The background color */
+int redrawScreen = 1;           /**< Boolean for whether screen needs to be redrawn */
 
+Region fieldFence;		/**< fence around playing field  */
 
-//Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}}; /**< Create a fence region */
+#define WORK_SLOTS 4
+static WorkItem workSlots[WORK_SLOTS];
+WorkQueue work;			/**< posted by wdt_c_handler, run by main */
 
-/** Advances a moving shape within a fence
- *  
- *  \param ml The moving shape to be advanced
- *  \param fence The region which will serve as a boundary for ml
- */
-void mlAdvance(MovLayer *ml, Region *fence)
+/** Deferred from wdt_c_handler: advance the movers */
+static void advanceMovers(void *m)
 {
-  Vec2 newPos;
-  u_char axis;
-  Region shapeBoundary;
-  for (; ml; ml = ml->next) {
-    vec2Add(&newPos, &ml->layer->pos, &ml->velocity);
-    abShapeGetBounds(ml->layer->abShape, &ml->layer->pos, &shapeBoundary);
-    for (axis = 0; axis < 2; axis ++) {
-      if ((shapeBoundary.topLeft.axes[axis] < fence->topLeft.axes[axis]) ||
-	  (shapeBoundary.botRight.axes[axis] > fence->botRight.axes[axis]) ) {
-	int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-	newPos.axes[axis] += (2*velocity);
-      }	/**< if outside of fence */
-    } /**< for axis */
-    ml->layer->pos = newPos;
-  } /**< for ml */
+  motionAdvance(m);
 }
 
-
-u_int bgColor = COLOR_BLUE;     /**< The background color */
-int redrawScreen = 1;           /**< Boolean for whether screen needs to be redrawn */
-
-Region fieldFence;		/**< fence around playing field  */
+/** Launch a puck from the center, despawning the oldest if all are in play */
+static void launchPuck()
+{
+  static const Vec2 puckVel[PUCKS] = {{3,1}, {-1,3}, {-2,-2}};
+  static Layer *pucks[PUCKS];	/**< oldest at nextPuck */
+  static u_char nextPuck;
+  Layer *l = pucks[nextPuck];
+  if (l)
+    layerPoolDespawn(&pool, l);	/**< its area is repainted by layerPoolRepaint */
+  pucks[nextPuck] = layerPoolSpawnMoving(&pool, &puckDesc, &screenCenter, 
+					 &puckVel[nextPuck], &fieldFence);
+  nextPuck = (nextPuck + 1) % PUCKS;
+}
 
 
 /** Initializes everything, enables interrupts and green LED, 
@@ -159,44 +130,74 @@ void main()
   P1OUT |= GREEN_LED;
 
   configureClocks();
+  timeInit();			/**< time base for cpuLoad */
   lcd_init();
   shapeInit();
   p2sw_init(1);
 
   shapeInit();
 
-  layerDraw(&layer0);
+  layerGroupUpdate(&ship);
+  layerPoolInit(&pool, puckSlots, PUCKS, &movers);
+  {				/**< link the static layers into the pool by z-order */
+    Layer *l, *next;
+    for (l = &layer0; l; l = next) {
+      next = l->next;
+      layerPoolInsert(&pool, l);
+    }
+  }
+  layerInit(pool.layers);
+  layerDraw(pool.layers);
 
   layerGetBounds(&fieldLayer, &fieldFence);
+  {
+    Vec2 v0 = {2,1}, v1 = {1,2}, v3 = {1,1};
+    motionAdd(&movers, &layer0, &v0, &fieldFence);
+    motionAdd(&movers, &layer1, &v1, &fieldFence);
+    motionAdd(&movers, &shipLayer, &v3, &fieldFence);
+  }
 
+  workInit(&work, workSlots, WORK_SLOTS);
   enableWDTInterrupts();      /**< enable periodic interrupt */
   or_sr(0x8);			            /**< GIE (enable interrupts) */
 
 
+  u_int switchesLast = 1;	/**< S1 up */
   for(;;) { 
-    while (!redrawScreen) { /**< Pause CPU if screen doesn't need updating */
+    u_int switches;
+    for (;;) {			/**< Pause CPU if no work */
+      unsigned int sr = critical_enter(); /**< no wakeup can slip in before sleeping */
+      if (redrawScreen || workPending(&work)) {
+	critical_exit(sr);
+	break;
+      }
       P1OUT &= ~GREEN_LED;    /**< Green led off with CPU */
-      or_sr(0x10);		        /**< CPU OFF */
+      idleSleep();		        /**< CPU OFF (interrupts on), time counted in cpuLoad */
+      critical_exit(sr);
     }
     P1OUT |= GREEN_LED;       /**< Green led on when CPU on */
     redrawScreen = 0;
-    movLayerDraw(&ml0, &layer0);
-    //layerDraw(&layer0);
+    workDrain(&work);		/**< run work posted by interrupt handlers */
+    switches = p2sw_read();
+    if (!(switches & 1) && (switchesLast & 1))
+      launchPuck();		/**< S1 pressed */
+    switchesLast = switches;
+    motionCommit(&movers);
+    motionDraw(&movers, pool.layers);
+    layerPoolRepaint(&pool);	/**< draw new pucks, erase removed ones */
     
   }
 }
 
-/** Watchdog timer interrupt handler. 15 interrupts/sec */
+u_char wdtTicksPerCall = 15;	/**< WDT ticks per wdt_c_handler call */
+
+/** Watchdog timer interrupt handler, called by wdt_handler.s every
+ *  wdtTicksPerCall ticks
+ */
 void wdt_c_handler()
 {
-  static short count = 0;
   P1OUT |= GREEN_LED;		      /**< Green LED on when cpu on */
-  count ++;
-  if (count == 15) {
-    mlAdvance(&ml0, &fieldFence);
-    if (p2sw_read())
-      redrawScreen = 1;
-    count = 0;
-  }
+  if (workPost(&work, advanceMovers, &movers))
+    redrawScreen = 1;		      /**< wake main to run it */
   P1OUT &= ~GREEN_LED;		    /**< Green LED off when cpu off */
 }
@@ -9,50 +9,41 @@
 
 	.extern redrawScreen
 	.extern wdt_c_handler
+	.extern wdtTicksPerCall
+;;; Watchdog interval interrupt.
+;;;
+;;; Most ticks only count: that fast path touches no registers (the
+;;; hardware saves SR).  Every wdtTicksPerCall ticks wdt_c_handler is
+;;; called, saving only R11-R15, which the C calling convention lets it
+;;; clobber (it saves R4-R10 itself if it uses them).  If it set
+;;; redrawScreen, the CPU is left on when main resumes.
+;;;
+;;; Cycles from interrupt request to the end of RETI (excluding the C
+;;; handler itself), from the MSP430 instruction timings:
+;;;   saving R4-R15 on every tick (before):	  82
+;;;   fast path (counting only):		  23
+;;;   full path (calling wdt_c_handler):	  63
 WDT:
-; start of function
-; attributes: interrupt 
-; framesize_regs:     24
-; framesize_locals:   0
-; framesize_outgoing: 0
-; framesize:          24
-; elim ap -> fp       26
-; elim fp -> sp       0
-; saved regs: R4 R5 R6 R7 R8 R9 R10 R11 R12 R13 R14 R15
-	; start of prologue
+	add.b	#1, &wdtTickCount		; 4 cycles
+	cmp.b	&wdtTicksPerCall, &wdtTickCount ; 6
+	jlo	wdt_done			; 2
+	mov.b	#0, &wdtTickCount		; 4
 	PUSH	R15
 	PUSH	R14
 	PUSH	R13
 	PUSH	R12
 	PUSH	R11
-	PUSH	R10
-	PUSH	R9
-	PUSH	R8
-	PUSH	R7
-	PUSH	R6
-	PUSH	R5
-	PUSH	R4
-	; end of prologue
 	CALL	#wdt_c_handler
-	; start of epilogue
-	POP	R4
-	POP	R5
-	POP	R6
-	POP	R7
-	POP	R8
-	POP	R9
-	POP	R10
 	POP	R11
 	POP	R12
 	POP	R13
 	POP	R14
 	POP	R15
 	cmp	#0, &redrawScreen
-	jz	ball_no_move
+	jz	wdt_done
 	and	#0xffef, 0(r1)	; clear CPU off in saved SR
-ball_no_move:	
+wdt_done:	
 	RETI
 	.size	WDT, .-WDT
-	.local	count
-	.comm	count,1,1
-	.ident	"GCC: (GNU) 4.9.1 20140707 (prerelease (msp430-14r1-364)) (GNUPro 14r1) (Based on: GCC 4.8 GDB 7.7 Binutils 2.24 Newlib 2.1)"
+	.local	wdtTickCount
+	.comm	wdtTickCount,1,1
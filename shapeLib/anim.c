@@ -0,0 +1,41 @@
+#include "shape.h"
+
+#define animFrame(anim) ((anim)->frames[(anim)->state->frame])
+
+void
+abAnimGetBounds(const AbAnim *anim, const Vec2 *centerPos, Region *bounds)
+{
+  abShapeGetBounds(animFrame(anim), centerPos, bounds);
+}
+
+int
+abAnimCheck(const AbAnim *anim, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  return abShapeCheck(animFrame(anim), centerPos, pixel);
+}
+
+int
+abAnimSpan(const AbAnim *anim, const Vec2 *centerPos, const Vec2 *pixel,
+	   int *runEnd, u_int *color)
+{
+  return abShapeSpan(animFrame(anim), centerPos, pixel, runEnd, color);
+}
+
+int
+abAnimTick(const AbAnim *anim, const Vec2 *centerPos, Region *dirty)
+{
+  AnimState *s = anim->state;
+  const Region *delta;
+  if (++s->ticks < anim->ticksPerFrame)
+    return 0;
+  s->ticks = 0;
+  delta = &anim->deltas[s->frame];
+  if (++s->frame == anim->numFrames)
+    s->frame = 0;
+  if (delta->botRight.axes[0] < delta->topLeft.axes[0]) /* frames are the same */
+    return 0;
+  vec2Add(&dirty->topLeft, &delta->topLeft, centerPos);
+  vec2Add(&dirty->botRight, &delta->botRight, centerPos);
+  regionClipScreen(dirty);
+  return 1;
+}
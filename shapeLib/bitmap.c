@@ -0,0 +1,52 @@
+#include "shape.h"
+
+void
+abBitmapGetBounds(const AbBitmap *bitmap, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft = *centerPos;
+  bounds->botRight.axes[0] = centerPos->axes[0] + bitmap->width - 1;
+  bounds->botRight.axes[1] = centerPos->axes[1] + bitmap->height - 1;
+}
+
+int
+abBitmapCheck(const AbBitmap *bitmap, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int endUnused;
+  u_int colorUnused;
+  return abBitmapSpan(bitmap, centerPos, pixel, &endUnused, &colorUnused);
+}
+
+// walks bits from pixel rightwards (whole bytes at a time) until one differs
+int
+abBitmapSpan(const AbBitmap *bitmap, const Vec2 *centerPos, const Vec2 *pixel,
+	     int *runEnd, u_int *color)
+{
+  int col = pixel->axes[0] - centerPos->axes[0];
+  int row = pixel->axes[1] - centerPos->axes[1];
+  u_char width = bitmap->width, mask, within, fill;
+  const u_char *p;
+  if (row < 0 || row >= bitmap->height || col >= width) { /* never within on this row */
+    *runEnd = SPAN_END;
+    return 0;
+  } else if (col < 0) {		/* left of bitmap */
+    *runEnd = centerPos->axes[0] - 1;
+    return 0;
+  }
+  p = &bitmap->bits[row * ((width + 7) >> 3) + (col >> 3)];
+  mask = 0x80 >> (col & 7);
+  within = (*p & mask) != 0;
+  fill = within ? 0xff : 0;
+  while (++col < width) {
+    if (!(mask >>= 1)) {	/* next byte: skip those entirely within run */
+      mask = 0x80;
+      for (p++; col + 8 <= width && *p == fill; p++)
+	col += 8;
+      if (col == width)
+	break;
+    }
+    if (((*p & mask) != 0) != within)
+      break;
+  }
+  *runEnd = (col == width && !within) ? SPAN_END : centerPos->axes[0] + col - 1;
+  return within;
+}
@@ -0,0 +1,52 @@
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "shape.h"
+
+extern const AbBitmap invader;	/* generated by makeBitmap from invader.ppm */
+extern const AbImage ship;	/* generated by makeBitmap from ship.ppm */
+extern const AbAnim walker;	/* generated by makeBitmap from walk0.ppm & walk1.ppm */
+
+const LayerDesc invaderDesc = {(const AbShape *)&invader, COLOR_GREEN, 0};
+const LayerDesc walkerDesc = {(const AbShape *)&walker, COLOR_BLACK, 2};
+const LayerDesc shipDesc = {(const AbShape *)&ship, COLOR_BLACK, 1};
+
+Layer walkerLayer = {
+  &walkerDesc,
+  {screenWidth/2 - 5, screenHeight/2},  /* top-left of walker */
+  {0,0}, {0,0},				    /* last & next pos */
+  0,
+};
+Layer shipLayer = {
+  &shipDesc,
+  {screenWidth/2 - 8, screenHeight - 30}, /* top-left of ship */
+  {0,0}, {0,0},				    /* last & next pos */
+  &walkerLayer,
+};
+Layer invaderLayer = {
+  &invaderDesc,
+  {screenWidth/2 - 5, 30},		    /* top-left of invader */
+  {0,0}, {0,0},				    /* last & next pos */
+  &shipLayer,
+};
+
+u_int bgColor = COLOR_BLACK;
+
+main()
+{
+  Region dirty;
+
+  configureClocks();
+  lcd_init();
+
+  clearScreen(COLOR_BLACK);
+  layerInit(&invaderLayer);
+  layerDraw(&invaderLayer);
+
+  for (;;) {			/* each tick, redraw only what the frame changed */
+    __delay_cycles(1000000);
+    if (abAnimTick(&walker, &walkerLayer.pos, &dirty))
+      layerDrawRegion(&invaderLayer, &dirty);
+  }
+}
@@ -0,0 +1,84 @@
+#include "shape.h"
+
+void
+abCompoundInit(const AbCompound *compound)
+{
+  abShapeGetBounds(compound->a, &compound->offsetA, &compound->bounds->a);
+  abShapeGetBounds(compound->b, &compound->offsetB, &compound->bounds->b);
+}
+
+void
+abCompoundGetBounds(const AbCompound *compound, const Vec2 *centerPos, Region *bounds)
+{
+  const CompoundBounds *cb = compound->bounds;
+  Region rel;
+  switch (compound->op) {
+  case COMPOUND_UNION:
+    regionUnion(&rel, &cb->a, &cb->b);
+    break;
+  case COMPOUND_INTERSECT:	/* (may be empty) */
+    vec2Max(&rel.topLeft, &cb->a.topLeft, &cb->b.topLeft);
+    vec2Min(&rel.botRight, &cb->a.botRight, &cb->b.botRight);
+    break;
+  default:
+    rel = cb->a;
+  }
+  vec2Add(&bounds->topLeft, &rel.topLeft, centerPos);
+  vec2Add(&bounds->botRight, &rel.botRight, centerPos);
+}
+
+/* span of one child, first rejecting pixels outside its cached bounds */
+static int
+childSpan(const AbShape *child, const Vec2 *offset, const Region *relBounds,
+	  const Vec2 *centerPos, const Vec2 *pixel, int *runEnd, u_int *color)
+{
+  Vec2 childPos;
+  int row = pixel->axes[1] - centerPos->axes[1];
+  int col = pixel->axes[0] - centerPos->axes[0];
+  if (row < relBounds->topLeft.axes[1] || row > relBounds->botRight.axes[1] ||
+      col > relBounds->botRight.axes[0]) { /* never within on this row */
+    *runEnd = SPAN_END;
+    return 0;
+  } else if (col < relBounds->topLeft.axes[0]) {
+    *runEnd = centerPos->axes[0] + relBounds->topLeft.axes[0] - 1;
+    return 0;
+  }
+  vec2Add(&childPos, centerPos, offset);
+  return abShapeSpan(child, &childPos, pixel, runEnd, color);
+}
+
+int
+abCompoundCheck(const AbCompound *compound, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int endUnused;
+  u_int colorUnused;
+  return abCompoundSpan(compound, centerPos, pixel, &endUnused, &colorUnused);
+}
+
+int
+abCompoundSpan(const AbCompound *compound, const Vec2 *centerPos, const Vec2 *pixel,
+	       int *runEnd, u_int *color)
+{
+  const CompoundBounds *cb = compound->bounds;
+  u_int colorA = *color;
+  int endB, inA, inB;
+  inA = childSpan(compound->a, &compound->offsetA, &cb->a, centerPos, pixel, runEnd, &colorA);
+  if (inA ? compound->op == COMPOUND_UNION : compound->op != COMPOUND_UNION) {
+    if (inA)			/* result follows a alone throughout its run */
+      *color = colorA;
+    return inA;
+  }
+  inB = childSpan(compound->b, &compound->offsetB, &cb->b, centerPos, pixel, &endB, color);
+  if (endB < *runEnd)
+    *runEnd = endB;
+  switch (compound->op) {
+  case COMPOUND_UNION:		/* (not within a) */
+    return inB;
+  case COMPOUND_INTERSECT:	/* (within a) */
+    *color = colorA;
+    return inB;
+  default:			/* (within a) */
+    *color = colorA;
+    return !inB;
+  }
+}
@@ -0,0 +1,55 @@
+#include "shape.h"
+
+void
+abImageGetBounds(const AbImage *image, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft = *centerPos;
+  bounds->botRight.axes[0] = centerPos->axes[0] + image->width - 1;
+  bounds->botRight.axes[1] = centerPos->axes[1] + image->height - 1;
+}
+
+int
+abImageCheck(const AbImage *image, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int endUnused;
+  u_int colorUnused;
+  return abImageSpan(image, centerPos, pixel, &endUnused, &colorUnused);
+}
+
+int
+abImageSpan(const AbImage *image, const Vec2 *centerPos, const Vec2 *pixel,
+	    int *runEnd, u_int *color)
+{
+  int col = pixel->axes[0] - centerPos->axes[0];
+  int row = pixel->axes[1] - centerPos->axes[1];
+  ImageCursor *c = image->cursor;
+  const u_char *runs = image->runs;
+  u_char run, index;
+  u_int next;
+  int end;
+  if (row < 0 || row >= image->height || col >= image->width) { /* never within on this row */
+    *runEnd = SPAN_END;
+    return 0;
+  } else if (col < 0) {		/* left of image */
+    *runEnd = centerPos->axes[0] - 1;
+    return 0;
+  }
+  if (c->row != row || c->col > col) { /* restart at beginning of row */
+    c->row = row;
+    c->col = 0;
+    c->offset = image->rows[row];
+  }
+  for (run = runs[c->offset]; c->col + imageRunLen(run) <= col; run = runs[++c->offset])
+    c->col += imageRunLen(run);
+  index = imageRunIndex(run);
+  end = c->col + imageRunLen(run);
+  for (next = c->offset + 1; end < image->width && imageRunIndex(runs[next]) == index; next++)
+    end += imageRunLen(runs[next]); /* merge runs of the same color */
+  if (index == IMAGE_CLEAR) {
+    *runEnd = end == image->width ? SPAN_END : centerPos->axes[0] + end - 1;
+    return 0;
+  }
+  *runEnd = centerPos->axes[0] + end - 1;
+  *color = image->palette[index];
+  return 1;
+}
@@ -2,35 +2,154 @@
 #include "lcddraw.h"
 #include "shape.h"
 
+void
+layerBoundsAt(const Layer *l, const Vec2 *pos, Region *bounds)
+{
+  const LayerGroup *g = l->desc->group;
+  if (g) {			/* cached bounds are relative to pos */
+    vec2Add(&bounds->topLeft, &g->bounds.topLeft, pos);
+    vec2Add(&bounds->botRight, &g->bounds.botRight, pos);
+  } else {
+    abShapeGetBounds(l->desc->abShape, pos, bounds);
+  }
+}
+
+static int layerProbe(const Layer *layers, const Vec2 *pixel, u_int *color);
+
+/** If layer l (or a member of group l) contains pixel, set *color 
+ *  and return true.
+ */
+static int
+layerProbeOne(const Layer *l, const Vec2 *pixel, u_int *color)
+{
+  const LayerDesc *desc = l->desc;
+  const LayerGroup *g = desc->group;
+  if (g) {
+    Vec2 relPos;		/* pixel relative to group */
+    vec2Sub(&relPos, pixel, &l->pos);
+    return (relPos.axes[0] >= g->bounds.topLeft.axes[0] && 
+	    relPos.axes[0] <= g->bounds.botRight.axes[0] &&
+	    relPos.axes[1] >= g->bounds.topLeft.axes[1] && 
+	    relPos.axes[1] <= g->bounds.botRight.axes[1] &&
+	    layerProbe(g->children, &relPos, color));
+  } else {			/* span, since shapes may set the color */
+    int endUnused;
+    u_int shapeColor = desc->color;
+    if (abShapeSpan(desc->abShape, &l->pos, pixel, &endUnused, &shapeColor)) {
+      *color = shapeColor;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/** Find the color of the topmost layer containing pixel.  
+ *  Returns false if there is none.
+ */
+static int
+layerProbe(const Layer *layers, const Vec2 *pixel, u_int *color)
+{
+  for (; layers; layers = layers->next)
+    if (layerProbeOne(layers, pixel, color))
+      return 1;
+  return 0;
+}
+
+/** Like layerProbeOne, but also finds the last column (*runEnd) of the
+ *  run of pixels starting at pixel with the same result.
+ */
+static int
+layerSpanOne(const Layer *l, const Vec2 *pixel, int *runEnd, u_int *color)
+{
+  const LayerDesc *desc = l->desc;
+  if (desc->group) {		/* groups are probed one pixel at a time */
+    *runEnd = pixel->axes[0];
+    return layerProbeOne(l, pixel, color);
+  }
+  *color = desc->color;
+  return abShapeSpan(desc->abShape, &l->pos, pixel, runEnd, color);
+}
+
 void
 layerDraw(Layer *layers)
 {
+  Region screen = {{0,0}, {screenWidth-1, screenHeight-1}};
+  layerDrawRegion(layers, &screen);
+} 
+
+void
+layerDrawRegion(Layer *layers, const Region *r)
+{
+  const Layer *cull[LAYER_CULL_MAX];
+  Region cullBounds[LAYER_CULL_MAX];
+  u_char numCull = 0, overflow = 0;
+  int left = r->topLeft.axes[0], right = r->botRight.axes[0];
+  Layer *l;
   int row, col;
-  for (row = 0; row < screenHeight; row++) {
-    lcd_setArea(0, row, screenWidth-1, row);
-    for (col = 0; col < screenWidth; col++) {
+
+  /* cull layers (and entire groups) whose bounds miss r */
+  for (l = layers; l; l = l->next) {
+    Region bounds;
+    layerBoundsAt(l, &l->pos, &bounds);
+    if (!regionIntersects(&bounds, r))
+      continue;
+    if (numCull == LAYER_CULL_MAX) {
+      overflow = 1;		/* too many: probe every layer */
+      break;
+    }
+    cull[numCull] = l;
+    cullBounds[numCull++] = bounds;
+  }
+
+  lcd_setArea(left, r->topLeft.axes[1], right, r->botRight.axes[1]);
+  for (row = r->topLeft.axes[1]; row <= r->botRight.axes[1]; row++) {
+    int runEnd[LAYER_CULL_MAX];	/* cull[i] is unchanged through runEnd[i] */
+    u_int runColor[LAYER_CULL_MAX];
+    u_char i, rowMask = 0;	/* bit i set if cull[i] spans this row */
+    u_char inside = 0;		/* bit i set if cull[i]'s run is within it */
+    for (i = 0; i < numCull; i++) { /* cull again to this scanline */
+      if (row >= cullBounds[i].topLeft.axes[1] && row <= cullBounds[i].botRight.axes[1])
+	rowMask |= 1 << i;
+      runEnd[i] = left - 1;
+    }
+    for (col = left; col <= right; ) {
       Vec2 pixelPos = {col, row};
       u_int color = bgColor;
-      Layer *probeLayer;
-      for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) {
-	if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	  color = probeLayer->color;
-	  break; 
-	} /* if check */
-      } // for checking all layers at col, row
-      lcd_writeColor(color); 
+      int end = right;		/* last col with this color */
+      if (overflow) {
+	layerProbe(layers, &pixelPos, &color);
+	end = col;
+      } else {
+	u_char mask, bit;
+	for (i = 0, mask = rowMask, bit = 1; mask; i++, mask >>= 1, bit <<= 1) {
+	  if (!(mask & 1))
+	    continue;
+	  if (runEnd[i] < col) { /* start cull[i]'s next run */
+	    if (layerSpanOne(cull[i], &pixelPos, &runEnd[i], &runColor[i]))
+	      inside |= bit;
+	    else
+	      inside &= ~bit;
+	  }
+	  if (runEnd[i] < end)
+	    end = runEnd[i];
+	  if (inside & bit) {	/* topmost layer within: lower layers don't matter */
+	    color = runColor[i];
+	    break;
+	  }
+	}
+      }
+      lcd_writeColorRun(color, end - col + 1);
+      col = end + 1;
     } // for col
   } // for row
-} 
-
-
+}
 
 void
 layerGetBounds(const Layer *l, Region *bounds)
 {
   Region lastBounds, curBounds;
-  abShapeGetBounds(l->abShape, &l->posLast, &lastBounds);
-  abShapeGetBounds(l->abShape, &l->pos, &curBounds);
+  layerBoundsAt(l, &l->posLast, &lastBounds);
+  layerBoundsAt(l, &l->pos, &curBounds);
   regionUnion(bounds, &curBounds, &lastBounds);
   regionClipScreen(bounds);
 }
@@ -42,6 +161,23 @@ layerInit(Layer *layer)
     layer->posLast = layer->posNext = layer->pos;
 }
 
+void
+layerGroupUpdate(LayerGroup *g)
+{
+  Layer *l = g->children;
+  layerInit(l);
+  if (!l) {
+    g->bounds.topLeft = g->bounds.botRight = vec2Zero;
+    return;
+  }
+  layerBoundsAt(l, &l->pos, &g->bounds);
+  for (l = l->next; l; l = l->next) {
+    Region bounds;
+    layerBoundsAt(l, &l->pos, &bounds);
+    regionUnion(&g->bounds, &g->bounds, &bounds);
+  }
+}
+
 /* void */
 /* layerDrawOld(Layer *layers) */
 /* { */
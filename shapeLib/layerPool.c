@@ -0,0 +1,144 @@
+#include "shape.h"
+
+/** Return the slot holding l, or 0 if l is not from pool */
+static PoolSlot *
+slotOf(const LayerPool *pool, Layer *l)
+{
+  PoolSlot *slot = (PoolSlot *)l;
+  if (slot >= pool->slots && slot < pool->slots + pool->numSlots)
+    return slot;
+  return 0;
+}
+
+/** Record that link now refers to l (if l is pooled) */
+static void
+setLink(const LayerPool *pool, Layer *l, Layer **link)
+{
+  PoolSlot *slot = slotOf(pool, l);
+  if (slot)
+    slot->link = link;
+}
+
+/** Add layer's area (at pos and posLast) to pool->dirty */
+static void
+addDirty(LayerPool *pool, const Layer *layer)
+{
+  Region bounds;
+  layerGetBounds(layer, &bounds);
+  if (pool->dirtyValid)
+    regionUnion(&pool->dirty, &pool->dirty, &bounds);
+  else
+    pool->dirty = bounds;
+  pool->dirtyValid = 1;
+}
+
+void
+layerPoolInit(LayerPool *pool, PoolSlot *slots, u_char numSlots, MotionSet *motion)
+{
+  u_char i;
+  pool->slots = slots;
+  pool->numSlots = numSlots;
+  pool->free = 0;
+  for (i = numSlots; i > 0; i--) { /* thread free list through next */
+    PoolSlot *slot = &slots[i-1];
+    slot->layer.next = (Layer *)pool->free;
+    pool->free = slot;
+  }
+  pool->layers = 0;
+  pool->motion = motion;
+  pool->dirtyValid = 0;
+}
+
+void
+layerPoolInsert(LayerPool *pool, Layer *layer)
+{
+  u_char z = layer->desc->z;
+  Layer **link = &pool->layers;
+  while (*link && (*link)->desc->z <= z)
+    link = &(*link)->next;
+  layer->next = *link;
+  *link = layer;
+  setLink(pool, layer->next, &layer->next);
+  setLink(pool, layer, link);
+}
+
+Layer *
+layerPoolSpawn(LayerPool *pool, const LayerDesc *desc, const Vec2 *pos)
+{
+  PoolSlot *slot = pool->free;
+  Layer *layer = (Layer *)slot;
+  if (slot) {
+    pool->free = (PoolSlot *)layer->next;
+    layer->desc = desc;
+    layer->pos = layer->posLast = layer->posNext = *pos;
+    slot->mover = -1;
+    layerPoolInsert(pool, layer);
+    addDirty(pool, layer);	/* drawn by layerPoolRepaint */
+  }
+  return layer;
+}
+
+Layer *
+layerPoolSpawnMoving(LayerPool *pool, const LayerDesc *desc, 
+		     const Vec2 *pos, const Vec2 *velocity, const Region *fence)
+{
+  Layer *layer;
+  if (!pool->motion || pool->motion->count == pool->motion->max)
+    return 0;
+  layer = layerPoolSpawn(pool, desc, pos);
+  if (layer)
+    ((PoolSlot *)layer)->mover = motionAdd(pool->motion, layer, velocity, fence);
+  return layer;
+}
+
+/** Remove mover i from pool->motion, updating the moved mover's slot */
+static void
+removeMover(LayerPool *pool, u_char i)
+{
+  MotionSet *m = pool->motion;
+  PoolSlot *moved;
+  motionRemove(m, i);
+  if (i < m->count && (moved = slotOf(pool, m->layer[i])))
+    moved->mover = i;		/* the last mover took index i */
+}
+
+void
+layerPoolDespawn(LayerPool *pool, Layer *layer)
+{
+  PoolSlot *slot = slotOf(pool, layer);
+  Layer **link;
+
+  if (slot) {
+    link = slot->link;
+    if (slot->mover >= 0)
+      removeMover(pool, slot->mover);
+  } else {			/* inserted layer: search for it */
+    for (link = &pool->layers; *link && *link != layer; link = &(*link)->next)
+      ;
+    if (pool->motion) {
+      int i = motionFind(pool->motion, layer);
+      if (i >= 0)
+	removeMover(pool, i);
+    }
+  }
+  if (*link == layer) {
+    *link = layer->next;
+    setLink(pool, layer->next, link);
+  }
+
+  addDirty(pool, layer);
+
+  if (slot) {
+    layer->next = (Layer *)pool->free;
+    pool->free = slot;
+  }
+}
+
+void
+layerPoolRepaint(LayerPool *pool)
+{
+  if (pool->dirtyValid) {
+    layerDrawRegion(pool->layers, &pool->dirty);
+    pool->dirtyValid = 0;
+  }
+}
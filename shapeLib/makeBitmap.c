@@ -0,0 +1,244 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "assert.h"
+
+// Generate AbBitmap and AbImage source from PPM images (run on the host).
+//
+//   makeBitmap mask NAME image.ppm > NAME.c	  1bpp AbBitmap
+//   makeBitmap image NAME image.ppm > NAME.c   run-length encoded AbImage
+//   makeBitmap anim NAME TICKS frame0.ppm frame1.ppm ... > NAME.c
+//						  AbAnim of AbImages, each
+//						  shown for TICKS ticks
+//
+// Magenta (255,0,255) pixels are transparent.  Other pixels are drawn:
+// in the layer's color for masks, or in their own color for images
+// (at most 15 colors per image).
+
+#define IMAGE_CLEAR 0		/* as in shape.h */
+#define MAX_COLORS 16
+#define MAX_RUN 16
+
+typedef struct {
+  int width, height;
+  unsigned int *pixels;		/* BGR 565 as lcd_writeColor expects, or ~0 if clear */
+} Ppm;
+
+#define CLEAR_PIXEL 0xffffffff
+
+// skip whitespace & comments, then read a decimal header field
+int ppmField(FILE *fp)
+{
+  int c, value;
+  while ((c = getc(fp)) == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n')
+    if (c == '#')
+      while ((c = getc(fp)) != '\n' && c != EOF)
+	;
+  ungetc(c, fp);
+  if (fscanf(fp, "%d", &value) != 1)
+    return -1;
+  return value;
+}
+
+// read a P3 (text) or P6 (binary) PPM with maxval 255
+int readPpm(const char *filename, Ppm *ppm)
+{
+  FILE *fp = fopen(filename, "rb");
+  char magic[3] = {0};
+  int maxval, i, binary;
+  if (!fp || fread(magic, 1, 2, fp) != 2 || magic[0] != 'P' ||
+      (magic[1] != '3' && magic[1] != '6')) {
+    fprintf(stderr, "makeBitmap: %s is not a PPM file\n", filename);
+    return 0;
+  }
+  binary = magic[1] == '6';
+  ppm->width = ppmField(fp);
+  ppm->height = ppmField(fp);
+  maxval = ppmField(fp);
+  if (ppm->width <= 0 || ppm->height <= 0 || ppm->width > 255 || ppm->height > 255 ||
+      maxval != 255) {
+    fprintf(stderr, "makeBitmap: %s must be at most 255x255 with maxval 255\n", filename);
+    return 0;
+  }
+  if (binary)
+    getc(fp);			/* single whitespace before raster */
+  ppm->pixels = malloc(ppm->width * ppm->height * sizeof(unsigned int));
+  assert(ppm->pixels);
+  for (i = 0; i < ppm->width * ppm->height; i++) {
+    int r, g, b;
+    if (binary) {
+      r = getc(fp); g = getc(fp); b = getc(fp);
+    } else {
+      r = ppmField(fp); g = ppmField(fp); b = ppmField(fp);
+    }
+    if (b < 0) {
+      fprintf(stderr, "makeBitmap: %s is truncated\n", filename);
+      return 0;
+    }
+    ppm->pixels[i] = (r == 255 && g == 0 && b == 255) ? CLEAR_PIXEL
+      : ((b >> 3) << 11) | ((g >> 2) << 5) | (r >> 3);
+  }
+  fclose(fp);
+  return 1;
+}
+
+void printMask(const char *name, const Ppm *ppm)
+{
+  int row, col, rowBytes = (ppm->width + 7) / 8;
+  printf("static const unsigned char %sBits[%d] = {\n", name, rowBytes * ppm->height);
+  for (row = 0; row < ppm->height; row++) {
+    printf("   ");
+    for (col = 0; col < rowBytes * 8; col += 8) {
+      int bit, byte = 0;
+      for (bit = 0; bit < 8; bit++)
+	if (col + bit < ppm->width && ppm->pixels[row * ppm->width + col + bit] != CLEAR_PIXEL)
+	  byte |= 0x80 >> bit;
+      printf(" 0x%02x,", byte);
+    }
+    printf(" // row %d\n", row);
+  }
+  printf("};\n\n");
+  printf("const AbBitmap %s = {abBitmapGetBounds, abBitmapCheck, abBitmapSpan, %d, %d, %sBits};\n",
+	 name, ppm->width, ppm->height, name);
+}
+
+// palette index of color, adding it to palette if new (-1 if full)
+int paletteIndex(unsigned int palette[], int *numColors, unsigned int color)
+{
+  int i;
+  if (color == CLEAR_PIXEL)
+    return IMAGE_CLEAR;
+  for (i = 1; i < *numColors; i++)
+    if (palette[i] == color)
+      return i;
+  if (*numColors == MAX_COLORS)
+    return -1;
+  palette[*numColors] = color;
+  return (*numColors)++;
+}
+
+// print an AbImage (static if isStatic)
+int printImage(const char *name, const Ppm *ppm, int isStatic)
+{
+  unsigned int palette[MAX_COLORS] = {0};
+  int numColors = 1, row, col, numRuns = 0, i;
+  unsigned char *runs = malloc(ppm->width * ppm->height);
+  int *rows = malloc(ppm->height * sizeof(int));
+  assert(runs && rows);
+  for (row = 0; row < ppm->height; row++) {
+    rows[row] = numRuns;
+    for (col = 0; col < ppm->width; ) {
+      int index = paletteIndex(palette, &numColors, ppm->pixels[row * ppm->width + col]);
+      int len = 1;
+      if (index < 0) {
+	fprintf(stderr, "makeBitmap: %s has more than %d colors\n", name, MAX_COLORS - 1);
+	return 0;
+      }
+      while (col + len < ppm->width && len < MAX_RUN &&
+	     ppm->pixels[row * ppm->width + col + len] == ppm->pixels[row * ppm->width + col])
+	len++;
+      runs[numRuns++] = (len - 1) << 4 | index;
+      col += len;
+    }
+  }
+  printf("static const unsigned int %sPalette[%d] = {", name, numColors);
+  for (i = 0; i < numColors; i++)
+    printf(" 0x%04x,", palette[i]);
+  printf(" };\n\n");
+  printf("static const unsigned char %sRuns[%d] = {", name, numRuns);
+  for (row = 0; row < ppm->height; row++) {
+    printf("\n   ");
+    for (i = rows[row]; i < (row + 1 < ppm->height ? rows[row + 1] : numRuns); i++)
+      printf(" 0x%02x,", runs[i]);
+  }
+  printf("\n};\n\n");
+  printf("static const unsigned int %sRows[%d] = {", name, ppm->height);
+  for (row = 0; row < ppm->height; row++)
+    printf("%s%d,", row % 12 ? " " : "\n    ", rows[row]);
+  printf("\n};\n\n");
+  printf("static ImageCursor %sCursor;\n\n", name);
+  printf("%sconst AbImage %s = {abImageGetBounds, abImageCheck, abImageSpan, %d, %d,\n"
+	 "  %sPalette, %sRuns, %sRows, &%sCursor};\n",
+	 isStatic ? "static " : "", name, ppm->width, ppm->height, name, name, name, name);
+  return 1;
+}
+
+// print the smallest rectangle containing the pixels that differ between
+// frames from and to, or an empty one if none do
+void printDelta(const Ppm *from, const Ppm *to, int fromIndex)
+{
+  int row, col, left = from->width, top = from->height, right = -1, bottom = -1;
+  for (row = 0; row < from->height; row++)
+    for (col = 0; col < from->width; col++)
+      if (from->pixels[row * from->width + col] != to->pixels[row * to->width + col]) {
+	if (col < left) left = col;
+	if (col > right) right = col;
+	if (row < top) top = row;
+	if (row > bottom) bottom = row;
+      }
+  if (right < 0)
+    printf("  {{1,0}, {0,0}}, // frame %d: unchanged\n", fromIndex);
+  else
+    printf("  {{%d,%d}, {%d,%d}}, // frame %d\n", left, top, right, bottom, fromIndex);
+}
+
+int printAnim(const char *name, int ticks, int numFrames, char **filenames)
+{
+  Ppm *frames = malloc(numFrames * sizeof(Ppm));
+  char frameName[100];
+  int i;
+  assert(frames);
+  if (ticks < 1 || ticks > 255 || numFrames > 255) {
+    fprintf(stderr, "makeBitmap: TICKS and the number of frames must be 1 to 255\n");
+    return 0;
+  }
+  for (i = 0; i < numFrames; i++) {
+    if (!readPpm(filenames[i], &frames[i]))
+      return 0;
+    if (frames[i].width != frames[0].width || frames[i].height != frames[0].height) {
+      fprintf(stderr, "makeBitmap: %s is not the size of %s\n", filenames[i], filenames[0]);
+      return 0;
+    }
+    sprintf(frameName, "%sFrame%d", name, i);
+    if (!printImage(frameName, &frames[i], 1))
+      return 0;
+    printf("\n");
+  }
+  printf("static const AbShape *const %sFrames[%d] = {\n", name, numFrames);
+  for (i = 0; i < numFrames; i++)
+    printf("  (const AbShape *)&%sFrame%d,\n", name, i);
+  printf("};\n\n");
+  printf("static const Region %sDeltas[%d] = {\n", name, numFrames);
+  for (i = 0; i < numFrames; i++)
+    printDelta(&frames[i], &frames[(i + 1) % numFrames], i);
+  printf("};\n\n");
+  printf("static AnimState %sState;\n\n", name);
+  printf("const AbAnim %s = {abAnimGetBounds, abAnimCheck, abAnimSpan, %d, %d,\n"
+	 "  %sFrames, %sDeltas, &%sState};\n",
+	 name, numFrames, ticks, name, name, name);
+  return 1;
+}
+
+int main(int argc, char **argv)
+{
+  Ppm ppm;
+  if (argc >= 5 && !strcmp(argv[1], "anim")) {
+    printf("// Automatically generated by makeBitmap from %s ...\n", argv[4]);
+    printf("#include \"shape.h\"\n\n");
+    return !printAnim(argv[2], atoi(argv[3]), argc - 4, &argv[4]);
+  }
+  if (argc != 4 || (strcmp(argv[1], "mask") && strcmp(argv[1], "image"))) {
+    fprintf(stderr, "usage: makeBitmap mask|image NAME image.ppm > NAME.c\n"
+	    "       makeBitmap anim NAME TICKS frame0.ppm frame1.ppm ... > NAME.c\n");
+    return 1;
+  }
+  if (!readPpm(argv[3], &ppm))
+    return 1;
+  printf("// Automatically generated by makeBitmap from %s\n", argv[3]);
+  printf("#include \"shape.h\"\n\n");
+  if (!strcmp(argv[1], "mask"))
+    printMask(argv[2], &ppm);
+  else if (!printImage(argv[2], &ppm, 0))
+    return 1;
+  return 0;
+}
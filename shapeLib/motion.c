@@ -0,0 +1,124 @@
+#include "shape.h"
+
+/* keep the compiler from moving pos accesses across seq updates */
+#define barrier() __asm__ __volatile__("" ::: "memory")
+
+static const Region unfenced = {{-0x7fff, -0x7fff}, {0x7fff, 0x7fff}};
+
+int
+motionAdd(MotionSet *m, Layer *l, const Vec2 *vel, const Region *fence)
+{
+  u_char i = m->count;
+  if (i == m->max)
+    return -1;
+  m->layer[i] = l;
+  m->pos[i] = l->posNext;
+  m->vel[i] = *vel;
+  m->hit[i] = 0;
+  motionSetFence(m, i, fence);
+  m->count = i + 1;
+  return i;
+}
+
+void
+motionSetFence(MotionSet *m, u_char i, const Region *fence)
+{
+  if (fence) {			/* shrink fence by shape's extent */
+    const Layer *l = m->layer[i];
+    Region shapeBounds;
+    Vec2 below, above;
+    layerBoundsAt(l, &m->pos[i], &shapeBounds);
+    vec2Sub(&below, &m->pos[i], &shapeBounds.topLeft);
+    vec2Sub(&above, &shapeBounds.botRight, &m->pos[i]);
+    vec2Add(&m->fence[i].topLeft, &fence->topLeft, &below);
+    vec2Sub(&m->fence[i].botRight, &fence->botRight, &above);
+  } else {
+    m->fence[i] = unfenced;
+  }
+}
+
+int
+motionFind(const MotionSet *m, const Layer *l)
+{
+  u_char i;
+  for (i = 0; i < m->count; i++)
+    if (m->layer[i] == l)
+      return i;
+  return -1;
+}
+
+void
+motionRemove(MotionSet *m, u_char i)
+{
+  u_char last = --m->count;
+  m->layer[i] = m->layer[last];
+  m->pos[i] = m->pos[last];
+  m->vel[i] = m->vel[last];
+  m->fence[i] = m->fence[last];
+  m->hit[i] = m->hit[last];
+}
+
+void
+motionAdvance(MotionSet *m)
+{
+  u_char i, axis, n = m->count;
+  m->seq++;			/* odd: pos is changing */
+  barrier();
+  for (i = 0; i < n; i++)
+    m->hit[i] = 0;
+  for (axis = 0; axis < 2; axis++) { /* one pass per axis over all movers */
+    u_char hitMin = axis ? MOTION_HIT_TOP : MOTION_HIT_LEFT;
+    u_char hitMax = axis ? MOTION_HIT_BOTTOM : MOTION_HIT_RIGHT;
+    for (i = 0; i < n; i++) {
+      int v = m->vel[i].axes[axis];
+      int p = m->pos[i].axes[axis] + v;
+      if (p < m->fence[i].topLeft.axes[axis]) {
+	m->hit[i] |= hitMin;
+      } else if (p > m->fence[i].botRight.axes[axis]) {
+	m->hit[i] |= hitMax;
+      } else {
+	m->pos[i].axes[axis] = p;
+	continue;
+      }
+      m->vel[i].axes[axis] = v = -v; /* reflect */
+      m->pos[i].axes[axis] = p + 2*v;
+    }
+  }
+  barrier();
+  m->seq++;			/* even: pos is consistent */
+}
+
+void
+motionCommit(MotionSet *m)
+{
+  u_char i, seq;
+  do {				/* snapshot pos into posNext */
+    seq = m->seq;
+    barrier();
+    for (i = 0; i < m->count; i++)
+      m->layer[i]->posNext = m->pos[i];
+    barrier();
+  } while ((seq & 1) || seq != m->seq);
+  for (i = 0; i < m->count; i++) {
+    Layer *l = m->layer[i];
+    l->posLast = l->pos;
+    l->pos = l->posNext;
+  }
+}
+
+void
+motionDraw(const MotionSet *m, Layer *layers)
+{
+  Region dirty[MOTION_DIRTY_MAX];
+  u_char i, j, numDirty = 0;
+  for (i = 0; i < m->count; i++) {
+    const Layer *l = m->layer[i];
+    Region bounds;
+    if (l->pos.axes[0] == l->posLast.axes[0] && l->pos.axes[1] == l->posLast.axes[1])
+      continue;			/* did not move */
+    layerGetBounds(l, &bounds);
+    regionSetAdd(dirty, &numDirty, MOTION_DIRTY_MAX, &bounds, 0);
+  }
+  for (j = 0; j < numDirty; j++)
+    layerDrawRegion(layers, &dirty[j]);
+}
@@ -0,0 +1,182 @@
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "shape.h"
+
+void
+particleInit(ParticleSys *ps, u_char *store, u_char budget, 
+	     u_int color, u_char size, const Region *fence)
+{
+  ps->budget = budget;
+  ps->count = 0;
+  ps->col = store;		/* carve store into parallel arrays */
+  ps->row = store + budget;
+  ps->colLast = store + 2*budget;
+  ps->rowLast = store + 3*budget;
+  ps->dCol = (signed char *)(store + 4*budget);
+  ps->dRow = (signed char *)(store + 5*budget);
+  ps->life = store + 6*budget;
+  ps->color = color;
+  ps->size = size;
+  ps->fence = *fence;
+}
+
+void
+particleEmit(ParticleSys *ps, u_char col, u_char row, 
+	     signed char dCol, signed char dRow, u_char life)
+{
+  u_char i = ps->count;
+  if (i < ps->budget) {
+    ps->col[i] = col; ps->row[i] = row;
+    ps->colLast[i] = PARTICLE_UNDRAWN;
+    ps->dCol[i] = dCol; ps->dRow[i] = dRow;
+    ps->life[i] = life;
+    ps->count = i + 1;
+  }
+}
+
+static const signed char burstDir[8][2] = {
+  {1,0}, {1,1}, {0,1}, {-1,1}, {-1,0}, {-1,-1}, {0,-1}, {1,-1}
+};
+
+void
+particleBurst(ParticleSys *ps, u_char col, u_char row, 
+	      u_char n, u_char speed, u_char life)
+{
+  u_char i;
+  for (i = 0; i < n; i++) {
+    signed char s = speed + (i >> 3); /* later rings are faster */
+    particleEmit(ps, col, row, burstDir[i & 7][0] * s, burstDir[i & 7][1] * s, life);
+  }
+}
+
+void
+particleAdvance(ParticleSys *ps)
+{
+  u_char i, n = ps->count;
+  u_char *col = ps->col, *row = ps->row, *life = ps->life;
+  const signed char *dCol = ps->dCol, *dRow = ps->dRow;
+  int colMin = ps->fence.topLeft.axes[0], colMax = ps->fence.botRight.axes[0] - ps->size;
+  int rowMin = ps->fence.topLeft.axes[1], rowMax = ps->fence.botRight.axes[1] - ps->size;
+  for (i = 0; i < n; i++) {
+    int c, r;
+    if (!life[i])
+      continue;
+    c = col[i] + dCol[i];
+    r = row[i] + dRow[i];
+    if (c < colMin || c > colMax || r < rowMin || r > rowMax) {
+      life[i] = 0;		/* left fence */
+    } else {
+      col[i] = c; row[i] = r;
+      life[i]--;
+    }
+  }
+}
+
+/** Live particles as an AbShape, built by particleDraw so the layer
+ *  compositor draws them above all layers.  Particle positions are 
+ *  absolute, so centerPos is ignored.
+ */
+typedef struct AbParticles_s {
+  void (*getBounds)(const struct AbParticles_s *shape, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbParticles_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbParticles_s *shape, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  const ParticleSys *ps;
+} AbParticles;
+
+static void
+abParticlesGetBounds(const AbParticles *shape, const Vec2 *centerPos, Region *bounds)
+{
+  *bounds = shape->ps->fence;	/* live particles never leave it */
+}
+
+static int
+abParticlesSpan(const AbParticles *shape, const Vec2 *centerPos, const Vec2 *pixel,
+		int *runEnd, u_int *color)
+{
+  const ParticleSys *ps = shape->ps;
+  int col = pixel->axes[0], row = pixel->axes[1], end = SPAN_END;
+  u_char i, size = ps->size;
+  for (i = 0; i < ps->count; i++) {
+    int c = ps->col[i], r = ps->row[i];
+    if (!ps->life[i] || row < r || row >= r + size)
+      continue;			/* dead or not on this row */
+    if (col < c) {		/* outside until this particle starts */
+      if (c - 1 < end)
+	end = c - 1;
+    } else if (col < c + size) {
+      *runEnd = c + size - 1;
+      return 1;
+    }
+  }
+  *runEnd = end;
+  return 0;
+}
+
+static int
+abParticlesCheck(const AbParticles *shape, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int runEnd;
+  u_int color;
+  return abParticlesSpan(shape, centerPos, pixel, &runEnd, &color);
+}
+
+/** Composite the n regions in dirty once each, with the particles
+ *  (overlay) above all other layers.
+ */
+static void
+drawDirty(Layer *overlay, const Region *dirty, u_char n)
+{
+  while (n--)
+    layerDrawRegion(overlay, dirty++);
+}
+
+void
+particleDraw(ParticleSys *ps, Layer *layers)
+{
+  AbParticles shape = {abParticlesGetBounds, abParticlesCheck, abParticlesSpan, ps};
+  LayerDesc desc = {(const AbShape *)&shape, ps->color, 0};
+  Layer overlay = {&desc, {0,0}, {0,0}, {0,0}, layers};
+  Region dirty[PARTICLE_DIRTY_MAX], square;
+  u_char i, numDirty = 0, size = ps->size;
+
+  /* collect the squares to erase and draw into a few disjoint regions */
+  for (i = 0; i < ps->count; i++) {
+    u_char c = ps->colLast[i], r = ps->rowLast[i], side;
+    for (side = 0; side < 2; side++) {
+      if (!side) {		/* live: drawn every pass, a mover may have erased it */
+	if (!ps->life[i])
+	  continue;
+	square.topLeft.axes[0] = ps->col[i];
+	square.topLeft.axes[1] = ps->row[i];
+      } else {			/* erase where it was, if it moved or died */
+	if (c == PARTICLE_UNDRAWN || (ps->life[i] && c == ps->col[i] && r == ps->row[i]))
+	  continue;
+	square.topLeft.axes[0] = c;
+	square.topLeft.axes[1] = r;
+      }
+      square.botRight.axes[0] = square.topLeft.axes[0] + size - 1;
+      square.botRight.axes[1] = square.topLeft.axes[1] + size - 1;
+      if (numDirty == PARTICLE_DIRTY_MAX) { /* full: draw rather than merge far apart squares */
+	drawDirty(&overlay, dirty, numDirty);
+	numDirty = 0;
+      }
+      regionSetAdd(dirty, &numDirty, PARTICLE_DIRTY_MAX, &square, PARTICLE_MERGE_SLACK);
+    }
+  }
+  drawDirty(&overlay, dirty, numDirty);
+
+  /* remove dead particles by moving the last into their slot */
+  for (i = 0; i < ps->count; ) {
+    if (ps->life[i]) {
+      ps->colLast[i] = ps->col[i]; ps->rowLast[i] = ps->row[i];
+      i++;
+    } else {
+      u_char last = --ps->count;
+      ps->col[i] = ps->col[last]; ps->row[i] = ps->row[last];
+      ps->colLast[i] = ps->colLast[last]; ps->rowLast[i] = ps->rowLast[last];
+      ps->dCol[i] = ps->dCol[last]; ps->dRow[i] = ps->dRow[last];
+      ps->life[i] = ps->life[last];
+    }
+  }
+}
@@ -0,0 +1,94 @@
+#include "shape.h"
+
+/* widen the edge table's row y (relative to center) to include column x */
+static void
+polyPlot(PolyEdges *e, int x, int y)
+{
+  signed char *row = e->rows[y - e->bounds.topLeft.axes[1]];
+  if (x < row[0])
+    row[0] = x;
+  if (x > row[1])
+    row[1] = x;
+}
+
+void
+abPolygonInit(const AbPolygon *poly)
+{
+  PolyEdges *e = poly->edges;
+  const Vec2 *v = poly->verts;
+  u_char i;
+  int row;
+
+  e->bounds.topLeft = e->bounds.botRight = v[0];
+  for (i = 1; i < poly->numVerts; i++) {
+    Vec2 *tl = &e->bounds.topLeft, *br = &e->bounds.botRight;
+    vec2Min(tl, tl, &v[i]);
+    vec2Max(br, br, &v[i]);
+  }
+  for (row = 0; row <= e->bounds.botRight.axes[1] - e->bounds.topLeft.axes[1]; row++) {
+    e->rows[row][0] = 127;	/* empty */
+    e->rows[row][1] = -128;
+  }
+  for (i = 0; i < poly->numVerts; i++) { /* step along each side */
+    const Vec2 *to = &v[i + 1 < poly->numVerts ? i + 1 : 0];
+    int x = v[i].axes[0], y = v[i].axes[1];
+    int x1 = to->axes[0], y1 = to->axes[1];
+    int dx = x1 > x ? x1 - x : x - x1, sx = x1 > x ? 1 : -1;
+    int dy = y1 > y ? y - y1 : y1 - y, sy = y1 > y ? 1 : -1; /* dy <= 0 */
+    int err = dx + dy;
+    for (;;) {
+      int err2 = err + err;
+      polyPlot(e, x, y);
+      if (x == x1 && y == y1)
+	break;
+      if (err2 >= dy) {
+	err += dy;
+	x += sx;
+      }
+      if (err2 <= dx) {
+	err += dx;
+	y += sy;
+      }
+    }
+  }
+}
+
+void
+abPolygonGetBounds(const AbPolygon *poly, const Vec2 *centerPos, Region *bounds)
+{
+  vec2Add(&bounds->topLeft, &poly->edges->bounds.topLeft, centerPos);
+  vec2Add(&bounds->botRight, &poly->edges->bounds.botRight, centerPos);
+}
+
+int
+abPolygonCheck(const AbPolygon *poly, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int endUnused;
+  u_int colorUnused;
+  return abPolygonSpan(poly, centerPos, pixel, &endUnused, &colorUnused);
+}
+
+int
+abPolygonSpan(const AbPolygon *poly, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color)
+{
+  const PolyEdges *e = poly->edges;
+  int row = pixel->axes[1] - centerPos->axes[1];
+  int left, right;
+  if (row < e->bounds.topLeft.axes[1] || row > e->bounds.botRight.axes[1]) {
+    *runEnd = SPAN_END;
+    return 0;
+  }
+  row -= e->bounds.topLeft.axes[1];
+  left = centerPos->axes[0] + e->rows[row][0];
+  right = centerPos->axes[0] + e->rows[row][1];
+  if (pixel->axes[0] > right) {	/* right of polygon */
+    *runEnd = SPAN_END;
+    return 0;
+  } else if (pixel->axes[0] < left) { /* left of polygon */
+    *runEnd = left - 1;
+    return 0;
+  }
+  *runEnd = right;
+  return 1;
+}
@@ -15,6 +15,26 @@ abRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel)
   return within;
 }
 
+// like abRectCheck, also finding the end of the run containing pixel
+int
+abRectSpan(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel,
+	   int *runEnd, u_int *color)
+{
+  Region bounds;
+  int col = pixel->axes[0], row = pixel->axes[1];
+  abRectGetBounds(rect, centerPos, &bounds);
+  if (row < bounds.topLeft.axes[1] || row >= bounds.botRight.axes[1] ||
+      col >= bounds.botRight.axes[0]) { /* never within on this row */
+    *runEnd = SPAN_END;
+    return 0;
+  } else if (col < bounds.topLeft.axes[0]) { /* left of rect */
+    *runEnd = bounds.topLeft.axes[0] - 1;
+    return 0;
+  }
+  *runEnd = bounds.botRight.axes[0] - 1;
+  return 1;
+}
+
 // compute bounding box in screen coordinates for rect at centerPos
 void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds)
 {
@@ -42,6 +62,33 @@ abRectOutlineCheck(const AbRectOutline *rect, const Vec2 *centerPos, const Vec2
 	  );
 }
  
+// like abRectOutlineCheck, also finding the end of the run containing pixel
+int
+abRectOutlineSpan(const AbRectOutline *rect, const Vec2 *centerPos, const Vec2 *pixel,
+		  int *runEnd, u_int *color)
+{
+  Region bounds;
+  int col = pixel->axes[0], row = pixel->axes[1];
+  int left, right;
+  abRectOutlineGetBounds(rect, centerPos, &bounds);
+  left = bounds.topLeft.axes[0]; right = bounds.botRight.axes[0];
+  if (row < bounds.topLeft.axes[1] || row > bounds.botRight.axes[1] || col > right) {
+    *runEnd = SPAN_END;		/* never within on this row */
+    return 0;
+  } else if (col < left) {
+    *runEnd = left - 1;
+    return 0;
+  } else if (row == bounds.topLeft.axes[1] || row == bounds.botRight.axes[1]) {
+    *runEnd = right;		/* top or bottom edge */
+    return 1;
+  } else if (col == left || col == right) {
+    *runEnd = col;		/* left or right edge */
+    return 1;
+  }
+  *runEnd = right - 1;		/* interior */
+  return 0;
+}
+ 
 // compute bounding box in screen coordinates for rect at centerPos
 void abRectOutlineGetBounds(const AbRectOutline *rect, const Vec2 *centerPos, Region *bounds)
 {
@@ -15,3 +15,54 @@ void regionClipScreen(Region *r)
   vec2Min(&r->botRight, &r->botRight, &screenSize);
 }
 
+
+// true if the (inclusive) regions overlap
+int
+regionIntersects(const Region *r1, const Region *r2)
+{
+  u_char axis;
+  for (axis = 0; axis < 2; axis ++)
+    if (r1->botRight.axes[axis] < r2->topLeft.axes[axis] ||
+	r2->botRight.axes[axis] < r1->topLeft.axes[axis])
+      return 0;
+  return 1;
+}
+
+// pixels in (inclusive) region r
+static u_int
+regionArea(const Region *r)
+{
+  return (u_int)(r->botRight.axes[0] - r->topLeft.axes[0] + 1) *
+    (r->botRight.axes[1] - r->topLeft.axes[1] + 1);
+}
+
+void
+regionSetAdd(Region *set, u_char *count, u_char max, const Region *r, u_int slack)
+{
+  Region grown = *r;
+  u_char j, n = *count;
+  for (;;) {			/* absorb regions until grown overlaps none */
+    u_char k;
+    u_int waste, least = 0xffff;
+    for (j = 0; j < n; j++)
+      if (regionIntersects(&set[j], &grown))
+	break;
+    if (j == n) {		/* disjoint: find the cheapest merge */
+      for (k = 0; k < n; k++) {
+	Region u;
+	regionUnion(&u, &set[k], &grown);
+	waste = regionArea(&u) - regionArea(&set[k]) - regionArea(&grown);
+	if (waste < least) {
+	  least = waste;
+	  j = k;
+	}
+      }
+      if (least > slack && n < max)
+	break;
+    }
+    regionUnion(&grown, &grown, &set[j]);
+    set[j] = set[--n];		/* grown is rechecked against the rest */
+  }
+  set[n] = grown;
+  *count = n + 1;
+}
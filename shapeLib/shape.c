@@ -19,6 +19,16 @@ abShapeGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds)
 int
 abShapeCheck(const AbShape *s, const Vec2 *centerPos, const Vec2 *pixelLoc)
 {
-  (*s->check)(s, centerPos, pixelLoc);
+  return (*s->check)(s, centerPos, pixelLoc);
 }
 
+
+int
+abShapeSpan(const AbShape *s, const Vec2 *centerPos, const Vec2 *pixelLoc,
+	    int *runEnd, u_int *color)
+{
+  if (s->span)
+    return (*s->span)(s, centerPos, pixelLoc, runEnd, color);
+  *runEnd = pixelLoc->axes[0];
+  return (*s->check)(s, centerPos, pixelLoc);
+}
@@ -62,6 +62,18 @@ void regionUnion(Region *rUnion, const Region *r1, const Region *r2);
  */
 void regionClipScreen(Region *region);
 
+/** True if regions r1 and r2 (inclusive) share at least one pixel.
+ */
+int regionIntersects(const Region *r1, const Region *r2);
+
+/** Add region r to a set of *count (at most max) disjoint regions.
+ *  r absorbs every region it overlaps (repeatedly, as it grows), so 
+ *  the set stays disjoint.  r is also merged with a disjoint region if
+ *  their union adds at most slack pixels that neither covers, or with
+ *  the one adding fewest if the set is full.
+ */
+void regionSetAdd(Region *set, u_char *count, u_char max, const Region *r, u_int slack);
+
 /** This function initializes the screen
  *  vectors that are used by shapes
  *
@@ -72,19 +84,29 @@ void shapeInit();
 /** Effectively a base class for Abstract Shapes
  *  
  *  Abstract Shapes have a shape but no position or color.
- *  The first two fields MUST BE pointers to
+ *  The first three fields MUST BE pointers to
  *
  *  getBounds: A function that computes the bounding box for the AbShape
  *  when rendered at coordinate centerPos
  * 
  *  check: A function that determines if the AbShape contains pixelLoc when 
  *  rendered at centerPos
+ *
+ *  span: (may be 0) Like check, but also stores in *runEnd the last
+ *  column of the horizontal run starting at pixelLoc for which the answer
+ *  (and color) does not change.  Shapes with more than one color may 
+ *  replace *color, which is initially the layer's color.  Renderers use 
+ *  span to draw whole runs rather than probing every pixel.
  */
 typedef struct AbShape_s{		/* base type for all abstrct shapes */
   void (*getBounds)(const struct AbShape_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbShape_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  int (*span)(const struct AbShape_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc, 
+	      int *runEnd, u_int *color);
 } AbShape;
 
+#define SPAN_END 0x7fff		/**< runEnd for a run that never ends */
+
 /** Computes bounding box of abShape in screen coordinates 
  *
  *  \param s (in) The abstract shape
@@ -102,6 +124,17 @@ void abShapeGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds);
  */
 int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
 
+/** Check if pixel is within the abShape centered at centerPos, and find
+ *  the run of pixels to its right with the same result.  Uses the 
+ *  shape's span function if it has one, otherwise the run is one pixel.
+ *
+ *  \param runEnd (out) The last column of the run
+ *  \param color (in & out) The color of the run (see AbShape)
+ *  \return True (1) if the run is in the abShape centered at centerPos 
+ */
+int abShapeSpan(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelLoc,
+		int *runEnd, u_int *color);
+
 /** An AbShape Right Arrow with filled tip
  *
  *  size: width of the arrow.  Tip is a triangle with width=1/2 size.
@@ -110,7 +143,9 @@ int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelL
 typedef struct AbRArrow_s {
   void (*getBounds)(const struct AbRArrow_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRArrow_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
-  int size;
+  int (*span)(const struct AbRArrow_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc,
+	      int *runEnd, u_int *color);
+  const int size;
 } AbRArrow;
 
 /** As required by AbShape
@@ -129,6 +164,8 @@ int abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixe
 typedef struct AbRect_s {
   void (*getBounds)(const struct AbRect_s *rect, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRect_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbRect_s *shape, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
   const Vec2 halfSize;	
 } AbRect;
 
@@ -140,6 +177,11 @@ void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds);
  */
 int abRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+int abRectSpan(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel,
+	       int *runEnd, u_int *color);
+
 typedef AbRect AbRectOutline;	/* same as AbRect */
 
 /** As required by AbShape
@@ -150,22 +192,376 @@ void abRectOutlineGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *b
  */
 int abRectOutlineCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+int abRectOutlineSpan(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel,
+		      int *runEnd, u_int *color);
+
+/** AbShape text string in the 5x7 font (lcdLib's font_5x7)
+ *
+ *  Unlike other shapes, centerPos is the top-left corner of the first
+ *  character, as with drawString5x7.  Characters are 6 columns apart
+ *  and 8 rows high.  The string itself may be changed (redraw the text's
+ *  bounds afterward).  Pixels not set in a glyph are not part of the
+ *  shape, so lower layers show between strokes.
+ */
+typedef struct AbText_s {
+  void (*getBounds)(const struct AbText_s *text, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbText_s *text, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbText_s *text, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  const char *string;
+} AbText;
+
+/** As required by AbShape
+ */
+void abTextGetBounds(const AbText *text, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abTextCheck(const AbText *text, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+int abTextSpan(const AbText *text, const Vec2 *centerPos, const Vec2 *pixel,
+	       int *runEnd, u_int *color);
+
+/** One entry of a tile map's palette.
+ *
+ *   - color: the tile's color
+ *   - pattern: 0 for a solid tile, otherwise 8 bytes, one per row, of an 
+ *     8x8 1bpp pattern (MSB leftmost) that repeats across the tile.  
+ *     Clear bits are transparent.
+ */
+typedef struct Tile_s {
+  u_int color;
+  const u_char *pattern;
+} Tile;
+
+#define TILE_EMPTY 0		/**< map cell with no tile */
+
+/** A grid of tiles, drawn as a single layer.
+ *
+ *  centerPos is the top-left corner of the map.  Each map cell is one
+ *  byte indexing tiles[]; cells holding TILE_EMPTY are transparent
+ *  (tiles[0] is never used).  Tiles are (1 << colShift) pixels wide and
+ *  (1 << rowShift) pixels high, so finding a pixel's tile takes only shifts.
+ *  The map itself is in RAM and may be edited with abTileMapSet.
+ */
+typedef struct AbTileMap_s {
+  void (*getBounds)(const struct AbTileMap_s *map, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbTileMap_s *map, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbTileMap_s *map, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  u_char cols, rows;		/**< map size in cells */
+  u_char colShift, rowShift;	/**< log2 of tile width & height */
+  u_char *cells;		/**< rows * cols cells, row by row */
+  const Tile *tiles;		/**< palette indexed by cell value */
+} AbTileMap;
+
+/** As required by AbShape
+ */
+void abTileMapGetBounds(const AbTileMap *map, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abTileMapCheck(const AbTileMap *map, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape.  Sets *color to the tile's color.
+ */
+int abTileMapSpan(const AbTileMap *map, const Vec2 *centerPos, const Vec2 *pixel,
+		  int *runEnd, u_int *color);
+
+/** Change one cell of a tile map.
+ *
+ *  \param map (in) The tile map
+ *  \param centerPos (in) Where the map is drawn
+ *  \param col, row (in) The cell to change
+ *  \param cell (in) The new cell value
+ *  \param dirty (out) The screen area of that cell, to be redrawn
+ *  \return True (1) if the cell changed
+ */
+int abTileMapSet(const AbTileMap *map, const Vec2 *centerPos, u_char col, u_char row,
+		 u_char cell, Region *dirty);
+
+/** Edge table of an AbPolygon, kept in RAM and filled by abPolygonInit.
+ *
+ *   - bounds: the polygon's bounding box relative to its center
+ *   - rows: for each row from bounds.topLeft down, the polygon's 
+ *     leftmost and rightmost columns relative to its center.  Must have 
+ *     room for one entry per row.
+ */
+typedef struct PolyEdges_s {
+  Region bounds;
+  signed char (*rows)[2];
+} PolyEdges;
+
+/** A filled convex polygon (a triangle has numVerts = 3).
+ *
+ *  Vertices are relative to the polygon's center, and must be within 
+ *  127 pixels of it.  Pixels are tested against a precomputed table of 
+ *  each row's left and right edges rather than against the polygon's
+ *  sides, so abPolygonInit must be called before it is drawn (or again
+ *  after verts change).
+ */
+typedef struct AbPolygon_s {
+  void (*getBounds)(const struct AbPolygon_s *poly, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbPolygon_s *poly, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbPolygon_s *poly, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  u_char numVerts;
+  const Vec2 *verts;
+  PolyEdges *edges;
+} AbPolygon;
+
+/** Compute poly's edge table by stepping along each side one pixel at a 
+ *  time (Bresenham), without division.
+ */
+void abPolygonInit(const AbPolygon *poly);
+
+/** As required by AbShape
+ */
+void abPolygonGetBounds(const AbPolygon *poly, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abPolygonCheck(const AbPolygon *poly, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+int abPolygonSpan(const AbPolygon *poly, const Vec2 *centerPos, const Vec2 *pixel,
+		  int *runEnd, u_int *color);
+
+/** A 1bpp bitmap drawn in its layer's color.
+ *
+ *  centerPos is the bitmap's top-left corner.  Each row of bits starts
+ *  on a byte boundary (MSB leftmost); clear bits are transparent.
+ *  makeBitmap (see Makefile) generates these from PPM images.
+ */
+typedef struct AbBitmap_s {
+  void (*getBounds)(const struct AbBitmap_s *bitmap, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbBitmap_s *bitmap, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbBitmap_s *bitmap, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  u_char width, height;
+  const u_char *bits;
+} AbBitmap;
+
+/** As required by AbShape
+ */
+void abBitmapGetBounds(const AbBitmap *bitmap, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abBitmapCheck(const AbBitmap *bitmap, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+int abBitmapSpan(const AbBitmap *bitmap, const Vec2 *centerPos, const Vec2 *pixel,
+		 int *runEnd, u_int *color);
+
+#define IMAGE_CLEAR 0		/**< AbImage palette index of transparent pixels */
+#define imageRun(index, len) (((len) - 1) << 4 | (index)) /**< AbImage run byte */
+#define imageRunIndex(run) ((run) & 0xf)
+#define imageRunLen(run) (((run) >> 4) + 1)
+
+/** Where an AbImage was last decoded: the run at byte offset of row,
+ *  which starts at column col (relative to the image).
+ */
+typedef struct ImageCursor_s {
+  u_char row, col;
+  u_int offset;
+} ImageCursor;
+
+/** A run-length encoded image of up to 15 colors.
+ *
+ *  centerPos is the image's top-left corner.  Each byte of runs is one 
+ *  run of 1 to 16 pixels of a single palette index (see imageRun); 
+ *  pixels of index IMAGE_CLEAR are transparent.  Runs never continue 
+ *  past the end of a row, and each row's runs begin at rows[row].  Runs 
+ *  are decoded onward from cursor (in RAM), so drawing rows left to 
+ *  right decodes each run once.  makeBitmap generates these from PPM images.
+ */
+typedef struct AbImage_s {
+  void (*getBounds)(const struct AbImage_s *image, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbImage_s *image, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbImage_s *image, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  u_char width, height;
+  const u_int *palette;
+  const u_char *runs;
+  const u_int *rows;
+  ImageCursor *cursor;
+} AbImage;
+
+/** As required by AbShape
+ */
+void abImageGetBounds(const AbImage *image, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abImageCheck(const AbImage *image, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape.  Sets *color from the image's palette.
+ */
+int abImageSpan(const AbImage *image, const Vec2 *centerPos, const Vec2 *pixel,
+		int *runEnd, u_int *color);
+
+/** Playback state of an AbAnim (in RAM).
+ */
+typedef struct AnimState_s {
+  u_char frame;			/**< frame being shown */
+  u_char ticks;			/**< ticks it has been shown */
+} AnimState;
+
+/** A sequence of same-sized frames (AbImages or AbBitmaps) played in 
+ *  a loop, each for ticksPerFrame calls of abAnimTick.
+ *
+ *  centerPos is the top-left corner.  deltas[i] is the area (relative to 
+ *  the top-left corner) that differs between frame i and the frame after
+ *  it, and is empty (botRight left of topLeft) if they are the same.
+ *  makeBitmap generates these from a list of PPM frames.
+ */
+typedef struct AbAnim_s {
+  void (*getBounds)(const struct AbAnim_s *anim, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbAnim_s *anim, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbAnim_s *anim, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  u_char numFrames, ticksPerFrame;
+  const AbShape *const *frames;
+  const Region *deltas;
+  AnimState *state;
+} AbAnim;
+
+/** As required by AbShape
+ */
+void abAnimGetBounds(const AbAnim *anim, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abAnimCheck(const AbAnim *anim, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+int abAnimSpan(const AbAnim *anim, const Vec2 *centerPos, const Vec2 *pixel,
+	       int *runEnd, u_int *color);
+
+/** Advance anim by one tick of its frame timer.
+ *
+ *  \param centerPos (in) Where the anim is drawn
+ *  \param dirty (out) If the frame changed, the screen area that differs
+ *  \return True (1) if dirty should be redrawn
+ */
+int abAnimTick(const AbAnim *anim, const Vec2 *centerPos, Region *dirty);
+
+#define COMPOUND_UNION 0	/**< pixels in either child */
+#define COMPOUND_INTERSECT 1	/**< pixels in both children */
+#define COMPOUND_DIFF 2		/**< pixels in child a but not child b */
+
+/** Bounds of an AbCompound's children, relative to its center.
+ *  In RAM, filled by abCompoundInit.
+ */
+typedef struct CompoundBounds_s {
+  Region a, b;
+} CompoundBounds;
+
+/** A shape combining two child shapes a and b by op (COMPOUND_UNION,
+ *  COMPOUND_INTERSECT or COMPOUND_DIFF).  Each child is centered at an 
+ *  offset from the compound's center.  Children are tested against
+ *  their bounds before their own check or span is called, and runs
+ *  are found from the children's spans.  Children may be compounds.
+ *  Pixels take the color of child a if they are within it, else of b.
+ */
+typedef struct AbCompound_s {
+  void (*getBounds)(const struct AbCompound_s *compound, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbCompound_s *compound, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*span)(const struct AbCompound_s *compound, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color);
+  u_char op;
+  const AbShape *a;
+  Vec2 offsetA;
+  const AbShape *b;
+  Vec2 offsetB;
+  CompoundBounds *bounds;
+} AbCompound;
+
+/** Cache the bounds of compound's children.  Call after initializing
+ *  the children (e.g. abPolygonInit) and before drawing.
+ */
+void abCompoundInit(const AbCompound *compound);
+
+/** As required by AbShape
+ */
+void abCompoundGetBounds(const AbCompound *compound, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abCompoundCheck(const AbCompound *compound, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+int abCompoundSpan(const AbCompound *compound, const Vec2 *centerPos, const Vec2 *pixel,
+		   int *runEnd, u_int *color);
+
+struct LayerGroup_s;
+
+/** Read-only portion of a layer.
+ *
+ *  Layer descriptors never change, so they should be declared const
+ *  (and are then placed in flash rather than RAM).  Several layers may
+ *  share a descriptor.  A layer's color is changed by pointing it at a 
+ *  different descriptor.
+ *
+ *   - abShape: the abstract shape to be rendered
+ *   - color: the shape's color
+ *   - z: z-order (smaller values are nearer the viewer)
+ *   - group: if non-zero, the layer is a group (see LayerGroup) and 
+ *     abShape and color are ignored
+ */
+typedef struct LayerDesc_s {
+  const AbShape *abShape;
+  u_int color;
+  u_char z;
+  struct LayerGroup_s *group;
+} LayerDesc;
+
 /** Linked list of Layers.  
  * 
- *  Each layer contains
- *   - a referenced to an abstract shape to be rendered.
- *   - the layer's current position
- *   - the layer's color
+ *  Each layer contains only the state that changes at runtime:
+ *   - a reference to the layer's (const) descriptor
+ *   - the layer's current, last-drawn, and next position
  *   - a reference to the next (lower) layer.
  */
 typedef struct Layer_s {
-  AbShape *abShape;
+  const LayerDesc *desc;
   Vec2 pos, posLast, posNext; /* initially just set pos */
-  u_int color;
   struct Layer_s *next;
 } Layer;	
 
-/** Compute layer's bounding box.
+/** Group of layers that move together.
+ *
+ *  A group is rendered by a layer whose descriptor refers to it.  The
+ *  children's positions are relative to that layer's position, so
+ *  moving the group layer moves every child.  bounds caches the union
+ *  of the children's bounds (also relative to the group layer), which 
+ *  lets the renderer skip the whole group when it misses the area being
+ *  drawn.
+ */
+typedef struct LayerGroup_s {
+  Layer *children;
+  Region bounds;
+} LayerGroup;
+
+/** Initialize children of group g and recompute its cached bounds.
+ *  Call again after moving or changing children.
+ */
+void layerGroupUpdate(LayerGroup *g);
+
+/** Compute layer's bounding box if it were centered at pos.
+ */
+void layerBoundsAt(const Layer *l, const Vec2 *pos, Region *bounds);
+
+/** Compute layer's bounding box (covering both pos and posLast).
  */
 void layerGetBounds(const Layer *l, Region *bounds);
 
@@ -179,6 +575,236 @@ void layerInit(Layer *layers);
  */
 void layerDraw(Layer *layers);
 
+/** Render the portion of all layers within region r (inclusive).
+ *  Pixels that are not contained by a layer are set to bgColor.
+ *
+ *  Only layers (and groups) whose bounds intersect r, and then the
+ *  current row, are probed.  If more than LAYER_CULL_MAX layers
+ *  intersect r, every layer is probed.
+ */
+void layerDrawRegion(Layer *layers, const Region *r);
+
+#define LAYER_CULL_MAX 8	/**< at most 8 (one bit per layer in a u_char) */
+
+/** Motion set: a group of moving layers.
+ *
+ *  Each mover's layer, next position, velocity, and fence are stored in 
+ *  parallel arrays (declared with MOTION_SET) so that motionAdvance
+ *  updates all movers in a single pass over contiguous memory.
+ *  
+ *  A mover's fence is the range of legal *center* positions: the 
+ *  fence passed to motionAdd shrunk by the extent of the mover's shape, 
+ *  so reflection requires only comparisons.  hit records which sides
+ *  of its fence each mover bounced off of during the last advance.
+ */
+typedef struct MotionSet_s {
+  u_char max, count;
+  Layer **layer;
+  Vec2 *pos;			/* next position */
+  Vec2 *vel;			/* change in position per advance */
+  Region *fence;		/* legal center positions */
+  u_char *hit;			/* MOTION_HIT_* bits */
+  volatile u_char seq;		/* odd while motionAdvance updates pos */
+} MotionSet;
+
+#define MOTION_HIT_LEFT 1
+#define MOTION_HIT_TOP 2
+#define MOTION_HIT_RIGHT 4
+#define MOTION_HIT_BOTTOM 8
+
+/** Declare (and define) a MotionSet called name with room for n movers.
+ */
+#define MOTION_SET(name, n)						\
+  static Layer *name##Layer[n];						\
+  static Vec2 name##Pos[n], name##Vel[n];				\
+  static Region name##Fence[n];						\
+  static u_char name##Hit[n];						\
+  MotionSet name = {n, 0, name##Layer, name##Pos, name##Vel, name##Fence, name##Hit}
+
+/** Add layer l as a mover with velocity vel, confined to fence.  
+ *  Fence may be 0 if the layer is unconstrained.
+ *  
+ *  \return the mover's index, or -1 if the set is full
+ */
+int motionAdd(MotionSet *m, Layer *l, const Vec2 *vel, const Region *fence);
+
+/** Confine mover i to fence (0 if unconstrained), shrunk by the extent
+ *  of its layer's shape.  Call again if the shape changes size.
+ */
+void motionSetFence(MotionSet *m, u_char i, const Region *fence);
+
+/** Return the index of l's mover, or -1 if l is not in m
+ */
+int motionFind(const MotionSet *m, const Layer *l);
+
+/** Remove mover i.  The last mover takes index i, so an index saved
+ *  for it (e.g., by motionAdd) is no longer valid: callers that keep
+ *  fixed mover indices must only remove the last mover.
+ */
+void motionRemove(MotionSet *m, u_char i);
+
+/** Advance every mover by its velocity, reflecting off its fence.
+ */
+void motionAdvance(MotionSet *m);
+
+/** Copy each mover's next position into its layer (saving posLast).
+ *  
+ *  motionAdvance may run in an interrupt handler: positions are read
+ *  under m->seq and reread if an advance intervened, so the layers get
+ *  a consistent snapshot without masking interrupts.
+ */
+void motionCommit(MotionSet *m);
+
+#define MOTION_DIRTY_MAX 4	/**< regions in a combined dirty set */
+
+/** Redraw the area vacated and entered by every mover that moved during
+ *  the last commit.  Overlapping areas are merged (repeatedly, as merged
+ *  areas grow) into at most MOTION_DIRTY_MAX disjoint regions, so no 
+ *  pixel is drawn twice.
+ */
+void motionDraw(const MotionSet *m, Layer *layers);
+
+/** Storage for one pooled layer (see LayerPool).
+ *
+ *  layer comes first, so a pooled Layer * is also its slot.  link is
+ *  the pointer in pool->layers that refers to layer, so it can be
+ *  unlinked without a search, and mover is layer's index in
+ *  pool->motion (-1 if it does not move).
+ */
+typedef struct PoolSlot_s {
+  Layer layer;
+  Layer **link;
+  signed char mover;
+} PoolSlot;
+
+/** Fixed-capacity pool of layers that can be spawned and despawned at runtime.
+ *
+ *  Slots are provided by the caller (typically a static array), so memory
+ *  use is fixed at link time and no heap is used.  Free slots are kept on
+ *  an intrusive free list threaded through layer.next, and each pooled
+ *  layer records where it is linked and its mover index, so despawning
+ *  a pooled layer takes constant time.  Spawning searches only for its
+ *  place in the z-order.
+ *
+ *  pool->layers must only be changed with the layerPool functions,
+ *  which keep pooled layers' links up to date.
+ *
+ *   - layers: all live layers (pooled or inserted) ordered by desc->z
+ *   - motion: where moving layers are added (may be 0)
+ *   - dirty: area of spawned and despawned layers that must be repainted
+ */
+typedef struct LayerPool_s {
+  PoolSlot *slots, *free;
+  u_char numSlots;
+  Layer *layers;
+  MotionSet *motion;
+  Region dirty;
+  u_char dirtyValid;		/* true if dirty is non-empty */
+} LayerPool;
+
+/** Initialize pool to use the numSlots entries of slots, all free.
+ *  Moving layers spawned from the pool are added to motion.
+ */
+void layerPoolInit(LayerPool *pool, PoolSlot *slots, u_char numSlots, MotionSet *motion);
+
+/** Link layer (which need not come from the pool) into pool->layers
+ *  according to its z-order.  Equal z-orders are inserted below
+ *  existing layers.
+ */
+void layerPoolInsert(LayerPool *pool, Layer *layer);
+
+/** Allocate a layer at pos and insert it by z-order.  Its area is
+ *  added to pool->dirty, so layerPoolRepaint draws it.
+ *  
+ *  \return the new layer, or 0 if the pool is exhausted
+ */
+Layer *layerPoolSpawn(LayerPool *pool, const LayerDesc *desc, const Vec2 *pos);
+
+/** Like layerPoolSpawn, but also adds the layer to pool->motion.
+ *  
+ *  \return the new layer, or 0 if the pool or motion set is exhausted
+ */
+Layer *layerPoolSpawnMoving(LayerPool *pool, const LayerDesc *desc, 
+			    const Vec2 *pos, const Vec2 *velocity, const Region *fence);
+
+/** Unlink layer from pool->layers (and pool->motion) and add the area
+ *  it occupied to pool->dirty.  Pooled layers are returned to the free
+ *  list in constant time; other layers (see layerPoolInsert) are found
+ *  by searching pool->layers and pool->motion, then just unlinked.
+ *  
+ *  Removing a mover renumbers the last mover (see motionRemove).
+ */
+void layerPoolDespawn(LayerPool *pool, Layer *layer);
+
+/** Repaint the area of layers spawned or despawned since the last
+ *  repaint (if any).
+ */
+void layerPoolRepaint(LayerPool *pool);
+
+/** Particle system
+ *
+ *  Particles are small (1 or 2 pixel) squares that are not layers.  
+ *  They are stored as parallel arrays so that all particles are
+ *  advanced in a single pass, and are composited above all layers in a
+ *  single pass over a few merged regions.  The arrays are carved out of a
+ *  caller-provided byte array of budget * PARTICLE_BYTES entries, so the
+ *  particle budget is chosen by each program.
+ *
+ *  Live particles occupy indices [0, count).  Particles die when their
+ *  lifetime expires or when they leave the fence.
+ */
+typedef struct ParticleSys_s {
+  u_char budget, count;
+  u_char *col, *row;		/* current positions */
+  u_char *colLast, *rowLast;	/* drawn positions (colLast = PARTICLE_UNDRAWN if none) */
+  signed char *dCol, *dRow;	/* velocities (pixels per advance) */
+  u_char *life;			/* remaining advances (0 = dead) */
+  u_int color;
+  u_char size;			/* width & height in pixels */
+  Region fence;
+} ParticleSys;
+
+#define PARTICLE_BYTES 7	/**< storage bytes per particle */
+#define PARTICLE_UNDRAWN 0xff
+#define PARTICLE_DIRTY_MAX 4	/**< regions particleDraw composites per batch */
+#define PARTICLE_MERGE_SLACK 16	/**< extra pixels worth one less area setup */
+
+/** Initialize particle system ps.
+ *
+ *  \param store (in) storage of budget * PARTICLE_BYTES bytes
+ *  \param budget Maximum number of live particles
+ *  \param color Particle color
+ *  \param size Particle width & height (1 or 2)
+ *  \param fence Particles that leave fence die
+ */
+void particleInit(ParticleSys *ps, u_char *store, u_char budget, 
+		  u_int color, u_char size, const Region *fence);
+
+/** Add one particle.  Ignored if the budget is exhausted.
+ */
+void particleEmit(ParticleSys *ps, u_char col, u_char row, 
+		  signed char dCol, signed char dRow, u_char life);
+
+/** Add n particles radiating from (col, row) in up to 8 directions.
+ */
+void particleBurst(ParticleSys *ps, u_char col, u_char row, 
+		   u_char n, u_char speed, u_char life);
+
+/** Advance all live particles by one step.
+ */
+void particleAdvance(ParticleSys *ps);
+
+/** Erase particles that have moved or died and draw live particles.
+ *  
+ *  The squares particles left and occupy are collected into batches of
+ *  at most PARTICLE_DIRTY_MAX disjoint regions (nearby squares are 
+ *  merged, see regionSetAdd), and each region is composited once from
+ *  layers (bgColor if layers is 0) with the live particles above them,
+ *  so no square is erased and then drawn.  Dead particles are then 
+ *  removed.
+ */
+void particleDraw(ParticleSys *ps, Layer *layers);
+
 /** Background color.
   */
 extern u_int bgColor;		/*  background color */
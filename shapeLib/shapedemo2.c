@@ -3,32 +3,46 @@
 #include "lcddraw.h"
 #include "shape.h"
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, 10,10};
-AbRArrow arrow30 = {abRArrowGetBounds, abRArrowCheck, 30};
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectSpan, 10,10};
+const AbRArrow arrow30 = {abRArrowGetBounds, abRArrowCheck, 0, 30};
+
+const Vec2 wedgeVerts[] = {{0,-15}, {20,10}, {-12,6}};
+signed char wedgeRows[26][2];	/* one per row, -15..10 */
+PolyEdges wedgeEdges = {{{0,0}, {0,0}}, wedgeRows};
+const AbPolygon wedge = {abPolygonGetBounds, abPolygonCheck, abPolygonSpan, 
+			 3, wedgeVerts, &wedgeEdges};
+
+const LayerDesc wedgeDesc = {(const AbShape *)&wedge, COLOR_GREEN, 3};
+const LayerDesc arrowDesc = {(const AbShape *)&arrow30, COLOR_BLACK, 2};
+const LayerDesc redRectDesc = {(const AbShape *)&rect10, COLOR_RED, 1};
+const LayerDesc orangeRectDesc = {(const AbShape *)&rect10, COLOR_ORANGE, 0};
 
 
 Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
 
 
+Layer layer3 = {
+  &wedgeDesc,
+  {screenWidth/2-30, screenHeight/2-35}, 	    /* position */
+  {0,0}, {0,0},				    /* last & next pos */
+  0,
+};
 Layer layer2 = {
-  (AbShape *)&arrow30,
+  &arrowDesc,
   {screenWidth/2+40, screenHeight/2+10}, 	    /* position */
   {0,0}, {0,0},				    /* last & next pos */
-  COLOR_BLACK,
-  0,
+  &layer3,
 };
 Layer layer1 = {
-  (AbShape *)&rect10,
+  &redRectDesc,
   {screenWidth/2, screenHeight/2}, 	    /* position */
   {0,0}, {0,0},				    /* last & next pos */
-  COLOR_RED,
   &layer2,
 };
 Layer layer0 = {
-  (AbShape *)&rect10,
+  &orangeRectDesc,
   {(screenWidth/2)+10, (screenHeight/2)+5}, /* position */
   {0,0}, {0,0},				    /* last & next pos */
-  COLOR_ORANGE,
   &layer1,
 };
 
@@ -46,6 +60,7 @@ main()
   drawString5x7(20,20, "hello", COLOR_GREEN, COLOR_RED);
   shapeInit();
   
+  abPolygonInit(&wedge);
   layerInit(&layer0);
   layerDraw(&layer0);
   
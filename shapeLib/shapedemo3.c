@@ -3,21 +3,23 @@
 #include "lcddraw.h"
 #include "shape.h"
 
-// like abRectCheck, but excludes a triangle
-int 
-abSlicedRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel)
-{
-  Vec2 relPos;
-  vec2Sub(&relPos, pixel, centerPos); /* vector from center to pixel */
-
-  /* reject pixels in slice */
-  if (relPos.axes[0] >= 0 && relPos.axes[0]/2 < relPos.axes[1]) 
-    return 0;
-  else
-    return abRectCheck(rect, centerPos, pixel);
-}
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectSpan, 10,10};
+
+// triangular slice from the center to the bottom-right of rect10
+const Vec2 sliceVerts[] = {{0,1}, {10,6}, {10,10}, {0,10}};
+signed char sliceRows[10][2];
+PolyEdges sliceEdges = {{{0,0}, {0,0}}, sliceRows};
+const AbPolygon slice = {abPolygonGetBounds, abPolygonCheck, abPolygonSpan, 
+			 4, sliceVerts, &sliceEdges};
+
+// rect10, excluding the slice
+CompoundBounds slicedRectBounds;
+const AbCompound slicedRect = {abCompoundGetBounds, abCompoundCheck, abCompoundSpan,
+			       COMPOUND_DIFF, (const AbShape *)&rect10, {0,0}, 
+			       (const AbShape *)&slice, {0,0}, &slicedRectBounds};
 
-AbRect rect10 = {abRectGetBounds, abSlicedRectCheck, 10,10};;
+const LayerDesc redRectDesc = {(const AbShape *)&slicedRect, COLOR_RED, 1};
+const LayerDesc orangeRectDesc = {(const AbShape *)&slicedRect, COLOR_ORANGE, 0};
 
 
 Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
@@ -25,17 +27,15 @@ Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
 
 #define numLayers 2
 Layer layer1 = {
-  (AbShape *)&rect10,
+  &redRectDesc,
   {screenWidth/2, screenHeight/2}, /* position */
   {0,0}, {0,0},				    /* last & next pos */
-  COLOR_RED,
   0,
 };
 Layer layer0 = {
-  (AbShape *)&rect10,
+  &orangeRectDesc,
   {(screenWidth/2)+15, (screenHeight/2)+10}, /* position */
   {0,0}, {0,0},				    /* last & next pos */
-  COLOR_ORANGE,
   &layer1,
 };
 
@@ -54,6 +54,8 @@ main()
   clearScreen(COLOR_BLUE);
   drawString5x7(20,20, "hello", COLOR_GREEN, COLOR_RED);
   shapeInit();
+  abPolygonInit(&slice);
+  abCompoundInit(&slicedRect);
   
   layerDraw(&layer0);
   
@@ -0,0 +1,73 @@
+#include "lcdutils.h"
+#include "shape.h"
+
+/* returns the bits of glyph column gcol (0..5) of character c; column 5 is the gap */
+static u_char
+glyphColumn(char c, u_char gcol)
+{
+  if (gcol == 5 || c < 0x20)
+    return 0;
+  return font_5x7[c - 0x20][gcol];
+}
+
+void
+abTextGetBounds(const AbText *text, const Vec2 *centerPos, Region *bounds)
+{
+  int len = 0;
+  const char *s;
+  for (s = text->string; *s; s++)
+    len++;
+  bounds->topLeft = *centerPos;
+  bounds->botRight.axes[0] = centerPos->axes[0] + (len ? 6*len - 2 : 0);
+  bounds->botRight.axes[1] = centerPos->axes[1] + 7;
+}
+
+int
+abTextCheck(const AbText *text, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int endUnused;
+  u_int colorUnused;
+  return abTextSpan(text, centerPos, pixel, &endUnused, &colorUnused);
+}
+
+// walks glyph columns from pixel rightwards until the pixel's bit changes
+int
+abTextSpan(const AbText *text, const Vec2 *centerPos, const Vec2 *pixel,
+	   int *runEnd, u_int *color)
+{
+  int col = pixel->axes[0] - centerPos->axes[0];
+  int row = pixel->axes[1] - centerPos->axes[1];
+  const char *s = text->string;
+  u_char bit, gcol, within;
+  if (row < 0 || row > 7) {
+    *runEnd = SPAN_END;
+    return 0;
+  } else if (col < 0) {
+    *runEnd = centerPos->axes[0] - 1;
+    return 0;
+  }
+  for (; col >= 6 && *s; col -= 6) /* find glyph containing pixel */
+    s++;
+  if (!*s) {			/* beyond end of string */
+    *runEnd = SPAN_END;
+    return 0;
+  }
+  bit = 1 << row;
+  gcol = col;
+  within = (glyphColumn(*s, gcol) & bit) != 0;
+  *runEnd = pixel->axes[0];
+  for (;;) {			/* extend run while the bit is unchanged */
+    if (++gcol == 6) {
+      gcol = 0;
+      if (!*++s) {
+	if (!within)
+	  *runEnd = SPAN_END;	/* blank to end of string & beyond */
+	break;
+      }
+    }
+    if (((glyphColumn(*s, gcol) & bit) != 0) != within)
+      break;
+    ++*runEnd;
+  }
+  return within;
+}
@@ -0,0 +1,73 @@
+#include "shape.h"
+
+void
+abTileMapGetBounds(const AbTileMap *map, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft = *centerPos;
+  bounds->botRight.axes[0] = centerPos->axes[0] + (map->cols << map->colShift) - 1;
+  bounds->botRight.axes[1] = centerPos->axes[1] + (map->rows << map->rowShift) - 1;
+}
+
+int
+abTileMapCheck(const AbTileMap *map, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int endUnused;
+  u_int colorUnused;
+  return abTileMapSpan(map, centerPos, pixel, &endUnused, &colorUnused);
+}
+
+int
+abTileMapSpan(const AbTileMap *map, const Vec2 *centerPos, const Vec2 *pixel,
+	      int *runEnd, u_int *color)
+{
+  int col = pixel->axes[0] - centerPos->axes[0];
+  int row = pixel->axes[1] - centerPos->axes[1];
+  const u_char *cellRow;
+  const Tile *tile;
+  u_char tx, value, within;
+  if (row < 0 || row >= (map->rows << map->rowShift) ||
+      col >= (map->cols << map->colShift)) { /* never within on this row */
+    *runEnd = SPAN_END;
+    return 0;
+  } else if (col < 0) {		/* left of map */
+    *runEnd = centerPos->axes[0] - 1;
+    return 0;
+  }
+  cellRow = &map->cells[(row >> map->rowShift) * map->cols];
+  tx = col >> map->colShift;
+  value = cellRow[tx];
+  tile = &map->tiles[value];
+  if (value == TILE_EMPTY || !tile->pattern) {
+    within = value != TILE_EMPTY;
+    while (++tx < map->cols && cellRow[tx] == value) /* merge identical cells */
+      ;
+    *runEnd = (tx == map->cols && !within) ? SPAN_END
+      : centerPos->axes[0] + (tx << map->colShift) - 1;
+  } else {			/* walk the pattern to the end of this tile */
+    u_char bits = tile->pattern[row & 7];
+    int tileEnd = (tx + 1) << map->colShift;
+    within = ((bits << (col & 7)) & 0x80) != 0;
+    while (++col < tileEnd && (((bits << (col & 7)) & 0x80) != 0) == within)
+      ;
+    *runEnd = centerPos->axes[0] + col - 1;
+  }
+  if (within)
+    *color = tile->color;
+  return within;
+}
+
+int
+abTileMapSet(const AbTileMap *map, const Vec2 *centerPos, u_char col, u_char row,
+	     u_char cell, Region *dirty)
+{
+  u_char *p = &map->cells[row * map->cols + col];
+  dirty->topLeft.axes[0] = centerPos->axes[0] + (col << map->colShift);
+  dirty->topLeft.axes[1] = centerPos->axes[1] + (row << map->rowShift);
+  dirty->botRight.axes[0] = dirty->topLeft.axes[0] + (1 << map->colShift) - 1;
+  dirty->botRight.axes[1] = dirty->topLeft.axes[1] + (1 << map->rowShift) - 1;
+  regionClipScreen(dirty);
+  if (*p == cell)
+    return 0;
+  *p = cell;
+  return 1;
+}
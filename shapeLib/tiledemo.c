@@ -0,0 +1,70 @@
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "shape.h"
+
+#define WALL_COLS 8
+#define WALL_ROWS 6
+
+const u_char checker[8] = {0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55};
+
+const Tile bricks[] = {
+  {0, 0},			/* TILE_EMPTY */
+  {COLOR_RED, 0},
+  {COLOR_ORANGE, 0},
+  {COLOR_GREEN, checker},
+};
+
+u_char wallCells[WALL_ROWS * WALL_COLS] = {
+  1,2,1,2,1,2,1,2,
+  2,1,2,1,2,1,2,1,
+  3,3,3,3,3,3,3,3,
+  1,2,1,2,1,2,1,2,
+  2,1,2,1,2,1,2,1,
+  0,3,0,3,0,3,0,3,
+};
+
+/* 16x8 pixel bricks */
+const AbTileMap wall = {abTileMapGetBounds, abTileMapCheck, abTileMapSpan,
+			WALL_COLS, WALL_ROWS, 4, 3, wallCells, bricks};
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectSpan, 10,10};
+
+const LayerDesc rectDesc = {(const AbShape *)&rect10, COLOR_WHITE, 0};
+const LayerDesc wallDesc = {(const AbShape *)&wall, COLOR_BLACK, 1};
+
+Layer wallLayer = {
+  &wallDesc,
+  {0, 20},			    /* top-left of the wall */
+  {0,0}, {0,0},				    /* last & next pos */
+  0,
+};
+Layer rectLayer = {
+  &rectDesc,
+  {screenWidth/2, 40},		    /* position */
+  {0,0}, {0,0},				    /* last & next pos */
+  &wallLayer,
+};
+
+u_int bgColor = COLOR_BLUE;
+
+main()
+{
+  u_char col, row;
+  Region dirty;
+
+  configureClocks();
+  lcd_init();
+
+  clearScreen(COLOR_BLUE);
+  layerInit(&rectLayer);
+  layerDraw(&rectLayer);
+
+  /* knock bricks out one at a time, redrawing only the brick's area */
+  for (row = 0; row < WALL_ROWS; row++)
+    for (col = 0; col < WALL_COLS; col++) {
+      __delay_cycles(4000000);
+      if (abTileMapSet(&wall, &wallLayer.pos, col, row, TILE_EMPTY, &dirty))
+	layerDrawRegion(&rectLayer, &dirty);
+    }
+}
@@ -1,6 +1,14 @@
 #include <msp430.h>
 #include "libTimer.h"
 
+#define DCO_HZ 16000000L
+#define VLO_PERIODS 8		/* ACLK periods timed by calibrateVlo */
+
+ClockPlan clockPlan = {DCO_HZ / 8, 0, DCO_HZ / 8 / 8192};
+
+static unsigned int wdtInterval = 1; /* WDTSSEL & WDTISx for enableWDTInterrupts */
+static unsigned int timerADivider = ID_0; /* keeps timer A at 2 MHz */
+
 void configureClocks(){
   WDTCTL = WDTPW + WDTHOLD;//Disable Watchdog Timer
   BCSCTL1 = CALBC1_16MHZ;  // Set DCO to 16 Mhz
@@ -10,15 +18,57 @@ void configureClocks(){
   BCSCTL2 |= DIVS_3;      // SMCLK = DCO / 8
 }
 
+// measure the VLO against SMCLK: time VLO_PERIODS rising edges of
+// ACLK (CCI0B) with timer A capture
+static unsigned long calibrateVlo()
+{
+  unsigned int start = 0, i;
+  TA0CTL = TASSEL_2 | MC_2 | TACLR; // count SMCLK continuously
+  TA0CCTL0 = CM_1 | CCIS_1 | CAP;   // capture on rising ACLK
+  for (i = 0; i <= VLO_PERIODS; i++) {
+    TA0CCTL0 &= ~CCIFG;
+    while (!(TA0CCTL0 & CCIFG))
+      ;
+    if (!i)
+      start = TA0CCR0;
+  }
+  i = TA0CCR0 - start;
+  TA0CCTL0 = 0;
+  TA0CTL = 0;
+  return clockPlan.smclkHz * VLO_PERIODS / i;
+}
+
+void configureClockPlan(unsigned char tickSource)
+{
+  WDTCTL = WDTPW + WDTHOLD;//Disable Watchdog Timer
+  BCSCTL1 = CALBC1_16MHZ;  // Set DCO to 16 Mhz
+  DCOCTL = CALDCO_16MHZ;
+
+  BCSCTL2 &= ~(SELS | DIVS_3); // SMCLK = DCO
+  clockPlan.smclkHz = DCO_HZ;
+  timerADivider = ID_3;	  // timer A still counts at 2 MHz
+
+  if (tickSource == TICK_WDT_VLO) {
+    BCSCTL3 = (BCSCTL3 & ~LFXT1S_3) | LFXT1S_2; // ACLK = VLO
+    BCSCTL1 &= ~DIVA_3;			       // ACLK undivided
+    clockPlan.vloHz = calibrateVlo();
+    wdtInterval = WDTSSEL | WDTIS1 | WDTIS0;	// ACLK / 64
+    clockPlan.tickHz = clockPlan.vloHz / 64;
+  } else {
+    wdtInterval = 0;				// SMCLK / 32768
+    clockPlan.tickHz = DCO_HZ / 32768;
+  }
+}
+
 
 // enable watchdog timer periodic interrupt
-// period = SMCLOCK/32k
+// period = SMCLOCK/8192, or as selected by configureClockPlan
 void enableWDTInterrupts()  
 {
   WDTCTL = WDTPW |	   // passwd req'd.  Otherwise device resets
     WDTTMSEL |		     // watchdog interval mode 
     WDTCNTCL |		     // clear watchdog count
-    1;			     // divide SMCLK by 8192
+    wdtInterval;	     // clock source & divider
   IE1 |= WDTIE;		   // Enable watchdog interval timer interrupt
 }
 
@@ -30,9 +80,7 @@ void timerAUpmode()
   TA0CCTL1 = OUTMOD_3;		/* Toggle p1.6 when timer=count1 */
   
   // Timer A control:
-  //  Timer clock source 2: system clock (SMCLK)
+  //  Timer clock source 2: system clock (SMCLK), divided to 2 MHz
   //  Mode Control 1: continuously 0...CCR0
-  TACTL = TASSEL_2 + MC_1;   
+  TACTL = TASSEL_2 + MC_1 + timerADivider;   
 }
-
-
@@ -2,6 +2,7 @@
 #define timerLib_included
 
 void configureClocks();
+void configureClockPlan(unsigned char tickSource);
 void enableWDTInterrupts();
 void timerAUpmode();
 
@@ -0,0 +1,37 @@
+#include "libTimer.h"
+
+CpuLoad cpuLoad;
+
+static unsigned long windowStart; // start of the current second
+static unsigned long windowIdle;  // cycles asleep so far this second
+static unsigned long worstBusy;	  // longest awake stretch this second
+static unsigned long wakeTime;	  // when the CPU last woke
+static unsigned char started;	  // windowStart and wakeTime are set
+
+void idleInit()
+{
+  windowStart = wakeTime = timeNow();
+  windowIdle = worstBusy = 0;
+  started = 1;
+}
+
+void idleSleep()
+{
+  unsigned long now, busy, window;
+  if (!started)			// first window starts now, not at timeInit
+    idleInit();
+  now = timeNow();
+  busy = now - wakeTime;
+  if (busy > worstBusy)
+    worstBusy = busy;
+  window = now - windowStart;
+  if (window >= clockPlan.smclkHz) { // a second has passed: publish it
+    cpuLoad.percent = 100 - windowIdle / (window / 100);
+    cpuLoad.worstBusy = worstBusy;
+    windowStart = now;
+    windowIdle = worstBusy = 0;
+  }
+  or_sr(0x18);			// GIE & CPU off until a handler wakes main
+  wakeTime = timeNow();
+  windowIdle += wakeTime - now;
+}
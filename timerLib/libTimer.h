@@ -1,11 +1,147 @@
 #ifndef libTimer_included
 #define libTimer_included
 
+/** Periodic tick sources for configureClockPlan */
+#define TICK_WDT_SMCLK 0	/* WDT interval from SMCLK / 32768 (488 Hz) */
+#define TICK_WDT_VLO 1		/* WDT interval from ACLK = VLO / 64 (~190 Hz) */
+
+/** Effective clock rates, as set by configureClocks or configureClockPlan */
+typedef struct {
+  unsigned long smclkHz;	/* SMCLK, which also clocks the LCD's SPI */
+  unsigned long vloHz;		/* measured VLO rate, if the tick uses it */
+  unsigned int tickHz;		/* WDT interval interrupt rate */
+} ClockPlan;
+
+extern ClockPlan clockPlan;
+
+/** Fixed-timestep scheduler.  The periodic interrupt handler calls
+ *  schedTick, which makes a simulation step due every ticksPerStep
+ *  ticks.  schedRun (from main) runs every step that is due, then
+ *  renders once.  When main falls behind, renders are skipped to catch
+ *  up but simulation steps never are.  Steps due is posted - taken;
+ *  each count has one writer, so neither side masks interrupts.
+ */
+typedef struct {
+  void (*step)();		/* advance the simulation one timestep */
+  void (*render)();		/* draw the current state */
+  unsigned char ticksPerStep;	/* interrupt ticks per timestep */
+  unsigned char tick;		/* ticks since the last step came due */
+  volatile unsigned char posted; /* steps made due (written by schedTick) */
+  volatile unsigned char taken;	/* steps run (written by schedRun) */
+  unsigned int steps;		/* steps run */
+  unsigned int frames;		/* renders run */
+  unsigned int skipped;		/* renders skipped to catch up */
+  volatile unsigned int late;	/* steps that came due before the last was run */
+} Scheduler;
+
+void schedInit(Scheduler *s, void (*step)(), void (*render)(), unsigned char ticksPerStep);
+int schedTick(Scheduler *s);	/* from the interrupt handler: 1 if a step came due */
+int schedRun(Scheduler *s);	/* from main: 0 if nothing was due */
+
+/** 32-bit monotonic time base: Timer1_A counts SMCLK cycles
+ *  (clockPlan.smclkHz per second), extended by its overflow interrupt.
+ *  Timer1_A is reserved for it once timeInit is called.  timeNow may be
+ *  called from main or from interrupt handlers.
+ */
+void timeInit();
+unsigned long timeNow();
+
+/** CPU load, measured by idleSleep over each second of the time base,
+ *  starting at its first call (or at idleInit).  Time in interrupt
+ *  handlers while the CPU is off counts as idle.
+ */
+typedef struct {
+  unsigned char percent;	/* share of the last second the CPU was on */
+  unsigned long worstBusy;	/* longest stretch awake in it, in SMCLK cycles */
+} CpuLoad;
+
+extern CpuLoad cpuLoad;
+
+/** Turn the CPU off (LPM0) until an interrupt handler wakes main,
+ *  accounting the time asleep in cpuLoad.  Requires timeInit.
+ *  Interrupts are enabled as the CPU turns off, so it may be called
+ *  with them disabled to close the gap between checking for work and
+ *  sleeping.
+ */
+void idleSleep();
+/** Restart cpuLoad's measurement now, e.g. after a stretch that never
+ *  sleeps.  Requires timeInit.
+ */
+void idleInit();
+
+/** Lock-free single-producer, single-consumer work queue.  An interrupt
+ *  handler posts work items (workPost) and main runs them (workDrain),
+ *  keeping slow work out of interrupt handlers.  head and tail count
+ *  freely, each written by only one side, so neither side masks
+ *  interrupts.  Items are stored in a caller-provided array whose size
+ *  is a power of 2, at most 128.
+ */
+typedef struct {
+  void (*fn)(void *arg);
+  void *arg;
+} WorkItem;
+
+typedef struct {
+  WorkItem *items;
+  unsigned char mask;		/* size - 1 */
+  volatile unsigned char head;	/* items posted (written by the producer) */
+  volatile unsigned char tail;	/* items run (written by the consumer) */
+  unsigned char dropped;	/* posts refused because the queue was full */
+} WorkQueue;
+
+void workInit(WorkQueue *q, WorkItem *items, unsigned char size);
+int workPost(WorkQueue *q, void (*fn)(void *), void *arg); /* 0 if full */
+unsigned char workDrain(WorkQueue *q); /* items run */
+#define workPending(q) ((q)->head != (q)->tail)
+
+/** Software timers on a hashed timer wheel driven by a periodic tick.
+ *  An expired timer's callback is posted to the WorkQueue given to
+ *  softTimerInit, so it runs in main (from workDrain), not in the
+ *  interrupt handler.  A tick visits only the timers in one slot of
+ *  the wheel, and starting a timer is O(1).
+ */
+typedef struct SoftTimer_s {
+  struct SoftTimer_s *next;	/* in its wheel slot */
+  unsigned int rounds;		/* turns of the wheel before it expires */
+  unsigned int period;		/* ticks between expiries (0: one-shot) */
+  void (*fn)(void *arg);
+  void *arg;
+  unsigned char slot;		/* wheel slot it's in */
+  unsigned char active;
+} SoftTimer;
+
+/** Post expired timers' callbacks to q; softTimerTick is called hz times/sec */
+void softTimerInit(WorkQueue *q, unsigned int hz);
+/** From the periodic interrupt handler.  Returns the number of callbacks
+ *  posted: if nonzero the handler should wake main.  A timer whose
+ *  callback can't be posted (queue full, counted in dropped) stays
+ *  pending and is retried next tick, so no expiry is lost.
+ */
+unsigned char softTimerTick();
+/** Run fn(arg) after ms, then every periodMs (unless 0) until cancelled */
+void softTimerStart(SoftTimer *t, unsigned int ms, unsigned int periodMs,
+		    void (*fn)(void *), void *arg);
+void softTimerCancel(SoftTimer *t);
+/** Sleep (with idleSleep) for ms, running other posted work meanwhile */
+void sleepMs(unsigned int ms);
+
 void configureClocks();
+void configureClockPlan(unsigned char tickSource);
 void enableWDTInterrupts();
 void timerAUpmode();
 
-unsigned char gert_sr();
+unsigned char get_sr();
 void set_sr(), or_sr(), and_sr();
 
+/** Nestable critical section: interrupts are disabled until the
+ *  matching critical_exit, which restores them only if they were
+ *  enabled at critical_enter.
+ *
+ *    unsigned int sr = critical_enter();
+ *    ...
+ *    critical_exit(sr);
+ */
+unsigned int critical_enter();
+void critical_exit(unsigned int sr);
+
 #endif // included
@@ -0,0 +1,44 @@
+#include "libTimer.h"
+#include "profile.h"
+
+ProfileFrame profileRing[PROFILE_FRAMES];
+unsigned char profileHead;
+
+static unsigned long stageCycles[PROFILE_STAGES]; // current frame
+static unsigned long lastMark;
+static unsigned char stage;	// stage running since lastMark
+
+void profileInit()
+{
+  timeInit();
+  lastMark = timeNow();
+}
+
+void profileMark(unsigned char next)
+{
+  unsigned long now = timeNow();
+  stageCycles[stage] += now - lastMark;
+  lastMark = now;
+  stage = next;
+}
+
+static unsigned int units(unsigned long cycles)
+{
+  cycles >>= PROFILE_SHIFT;
+  return cycles > 0xffff ? 0xffff : cycles;
+}
+
+void profileFrame()
+{
+  ProfileFrame *f = &profileRing[profileHead];
+  unsigned long total = 0;
+  unsigned char i;
+  profileMark(stage);		// charge the running stage up to now
+  for (i = 0; i < PROFILE_STAGES; i++) {
+    total += stageCycles[i];
+    f->stage[i] = units(stageCycles[i]);
+    stageCycles[i] = 0;
+  }
+  f->total = units(total);
+  profileHead = (profileHead + 1) & (PROFILE_FRAMES - 1);
+}
@@ -0,0 +1,56 @@
+#ifndef profile_included
+#define profile_included
+
+/** Per-stage frame profiler.
+ *
+ *  The application divides each frame into up to PROFILE_STAGES stages
+ *  (e.g. simulation, collision, drawing, idle).  PROFILE_MARK(stage)
+ *  charges the cycles since the previous mark to the stage then running
+ *  and starts stage; PROFILE_FRAME() closes the frame, appending a
+ *  record to profileRing.  Cycles are read from the time base
+ *  (timeNow), so PROFILE_INIT() starts it.
+ *
+ *  profileRing is an ordinary global so a simulator or debugger can
+ *  dump it by name (e.g. mspdebug's "md profileRing 48").
+ *
+ *  All of this compiles out unless PROFILE is defined.
+ */
+
+#define PROFILE_STAGES 5
+#define PROFILE_FRAMES 4	/* records in profileRing (a power of 2) */
+#define PROFILE_SHIFT 5		/* records count units of 32 cycles */
+
+typedef struct {
+  unsigned int total;		/* frame time (saturates at 0xffff) */
+  unsigned int stage[PROFILE_STAGES]; /* time spent in each stage */
+} ProfileFrame;
+
+extern ProfileFrame profileRing[PROFILE_FRAMES];
+extern unsigned char profileHead; /* index of the next record written */
+
+void profileInit();
+void profileMark(unsigned char stage);
+void profileFrame();
+
+/** Draw the frame time (ms) and each stage's percentage, averaged over
+ *  profileRing, in the 5x7 font (defined in lcdLib).
+ */
+void profileDraw(int col, int row, unsigned int fgColorBGR, unsigned int bgColorBGR);
+
+#ifdef PROFILE
+#define PROFILE_INIT() profileInit()
+#define PROFILE_MARK(stage) profileMark(stage)
+#define PROFILE_FRAME() profileFrame()
+/** Redraw the overlay once per pass over profileRing */
+#define PROFILE_DRAW(col, row) do {				\
+    if (!profileHead)						\
+      profileDraw(col, row, 0xffff, 0);				\
+  } while (0)
+#else
+#define PROFILE_INIT()
+#define PROFILE_MARK(stage)
+#define PROFILE_FRAME()
+#define PROFILE_DRAW(col, row)
+#endif
+
+#endif // included
@@ -0,0 +1,45 @@
+#include <msp430.h>
+#include "libTimer.h"
+
+void schedInit(Scheduler *s, void (*step)(), void (*render)(), unsigned char ticksPerStep)
+{
+  s->step = step;
+  s->render = render;
+  s->ticksPerStep = ticksPerStep ? ticksPerStep : 1;
+  s->tick = 0;
+  s->posted = s->taken = 0;
+  s->steps = s->frames = s->skipped = s->late = 0;
+}
+
+// called from the periodic interrupt handler
+int schedTick(Scheduler *s)
+{
+  unsigned char due;
+  if (++s->tick < s->ticksPerStep)
+    return 0;
+  s->tick = 0;
+  due = s->posted - s->taken;
+  if (due)			// previous step still waiting: main is behind
+    s->late++;
+  if (due != 0xff)
+    s->posted++;
+  return 1;
+}
+
+// called from main: catch up on every step due, then render once
+int schedRun(Scheduler *s)
+{
+  unsigned char ran = 0;
+  while (s->taken != s->posted) {
+    s->step();
+    s->taken++;
+    ran++;
+  }
+  if (!ran)
+    return 0;
+  s->steps += ran;
+  s->skipped += ran - 1;	// renders that would have followed earlier steps
+  s->frames++;
+  s->render();
+  return 1;
+}
@@ -0,0 +1,119 @@
+#include "libTimer.h"
+
+#define WHEEL_SHIFT 3
+#define WHEEL_SLOTS (1 << WHEEL_SHIFT)
+
+static SoftTimer *wheel[WHEEL_SLOTS]; // timers due when now reaches their slot
+static unsigned char now;	      // current slot
+static WorkQueue *queue;	      // where expired timers' callbacks go
+static unsigned int tickHz;
+
+void softTimerInit(WorkQueue *q, unsigned int hz)
+{
+  queue = q;
+  tickHz = hz;
+}
+
+// insert t to expire in ticks (>= 1) ticks; interrupts must be off
+static void insert(SoftTimer *t, unsigned int ticks)
+{
+  unsigned char i = (now + ticks) & (WHEEL_SLOTS - 1);
+  SoftTimer **slot = &wheel[i];
+  t->slot = i;
+  t->rounds = (ticks - 1) >> WHEEL_SHIFT;
+  t->next = *slot;
+  *slot = t;
+  t->active = 1;
+}
+
+// unlink t from its slot; interrupts must be off
+static void unlink(SoftTimer *t)
+{
+  SoftTimer **p;
+  for (p = &wheel[t->slot]; *p; p = &(*p)->next)
+    if (*p == t) {
+      *p = t->next;
+      t->active = 0;
+      return;
+    }
+}
+
+static unsigned int msToTicks(unsigned int ms)
+{
+  unsigned long ticks = ((unsigned long)ms * tickHz + 999) / 1000;
+  return ticks ? ticks : 1;
+}
+
+void softTimerStart(SoftTimer *t, unsigned int ms, unsigned int periodMs,
+		    void (*fn)(void *), void *arg)
+{
+  unsigned int sr = critical_enter(); // softTimerTick walks the wheel
+  if (t->active)
+    unlink(t);
+  t->fn = fn;
+  t->arg = arg;
+  t->period = periodMs ? msToTicks(periodMs) : 0;
+  insert(t, msToTicks(ms));
+  critical_exit(sr);
+}
+
+void softTimerCancel(SoftTimer *t)
+{
+  unsigned int sr = critical_enter();
+  if (t->active)
+    unlink(t);
+  critical_exit(sr);
+}
+
+// called from the periodic interrupt handler: only the current slot is
+// visited, so the cost doesn't grow with the number of timers pending
+unsigned char softTimerTick()
+{
+  SoftTimer **p, *t, *again = 0;
+  unsigned char posted = 0;
+  now = (now + 1) & (WHEEL_SLOTS - 1);
+  for (p = &wheel[now]; (t = *p); ) {
+    if (t->rounds) {		// not this turn of the wheel
+      t->rounds--;
+      p = &t->next;
+      continue;
+    }
+    *p = t->next;		// expired: unlink
+    if (!workPost(queue, t->fn, t->arg)) {
+      insert(t, 1);		// queue full: retry next tick (another slot)
+      continue;
+    }
+    posted++;
+    t->active = 0;
+    if (t->period) {		// reinsert after the walk
+      t->next = again;
+      again = t;
+    }
+  }
+  while ((t = again)) {
+    again = t->next;
+    insert(t, t->period);
+  }
+  return posted;
+}
+
+static void wake(void *done)
+{
+  *(volatile unsigned char *)done = 1;
+}
+
+void sleepMs(unsigned int ms)
+{
+  SoftTimer t = {0};
+  volatile unsigned char done = 0;
+  softTimerStart(&t, ms, 0, wake, (void *)&done);
+  while (!done) {
+    unsigned int sr;
+    if (workDrain(queue))	// run other expired timers meanwhile
+      continue;
+    sr = critical_enter();	// no post can slip in before sleeping
+    if (!workPending(queue))
+      idleSleep();
+    critical_exit(sr);
+  }
+}
@@ -19,3 +19,18 @@ or_sr:	bis r12, r2
 	.global and_sr
 and_sr:	and r12, r2
 	ret
+
+	;; critical sections that nest: critical_enter returns the sr
+	;; it found, critical_exit re-enables interrupts only if they
+	;; were enabled then
+
+	.global critical_enter
+critical_enter:	mov r2, r12
+	dint
+	nop			; dint takes effect after one instruction
+	ret
+
+	.global critical_exit
+critical_exit:	and #8, r12	; GIE as it was
+	bis r12, r2
+	ret
@@ -0,0 +1,31 @@
+#include <msp430.h>
+#include "libTimer.h"
+
+static volatile unsigned int timeHigh; // Timer1_A overflows: upper 16 bits
+
+void timeInit()
+{
+  timeHigh = 0;
+  TA1CTL = TASSEL_2 | MC_2 | TACLR | TAIE; // count SMCLK continuously
+}
+
+// timeHigh doubles as a sequence count: if the overflow handler ran
+// while reading, read again.  Safe with interrupts enabled or disabled
+// (e.g. within a handler), where a pending overflow is counted here.
+unsigned long timeNow()
+{
+  unsigned int high, low;
+  unsigned char pending;
+  do {
+    high = timeHigh;
+    low = TA1R;
+    pending = (TA1CTL & TAIFG) && !(low & 0x8000); // wrapped, not yet counted
+  } while (high != timeHigh);
+  return ((unsigned long)(high + pending) << 16) | low;
+}
+
+__interrupt(TIMER1_A1_VECTOR) timer1Overflow()
+{
+  if (TA1IV == TA1IV_TAIFG)	// reading TA1IV clears TAIFG
+    timeHigh++;
+}
@@ -0,0 +1,45 @@
+#include "libTimer.h"
+
+// keep the compiler from moving item accesses across head/tail updates
+#define barrier() __asm__ __volatile__("" ::: "memory")
+
+void workInit(WorkQueue *q, WorkItem *items, unsigned char size)
+{
+  q->items = items;
+  q->mask = size - 1;
+  q->head = q->tail = 0;
+  q->dropped = 0;
+}
+
+// producer (one interrupt handler): only it writes head
+int workPost(WorkQueue *q, void (*fn)(void *), void *arg)
+{
+  unsigned char head = q->head;
+  WorkItem *item;
+  if ((unsigned char)(head - q->tail) > q->mask) { // full
+    q->dropped++;
+    return 0;
+  }
+  item = &q->items[head & q->mask];
+  item->fn = fn;
+  item->arg = arg;
+  barrier();			// item is complete before it's published
+  q->head = head + 1;
+  return 1;
+}
+
+// consumer (main): only it writes tail
+unsigned char workDrain(WorkQueue *q)
+{
+  unsigned char n = 0, tail = q->tail;
+  while (tail != q->head) {
+    WorkItem item;
+    barrier();			// read the item after seeing it published
+    item = q->items[tail & q->mask];
+    barrier();
+    q->tail = ++tail;		// slot is free once copied
+    item.fn(item.arg);
+    n++;
+  }
+  return n;
+}